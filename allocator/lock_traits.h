@@ -0,0 +1,34 @@
+#ifndef _LOCK_TRAITS_H_
+#define _LOCK_TRAITS_H_
+
+#include <atomic>
+
+// Single-threaded policy: lock state is empty and the guard compiles away completely
+struct no_lock {
+  struct lock_type {};
+
+  struct guard {
+    explicit guard(lock_type &) {}
+  };
+};
+
+// Multi-threaded policy: a test-and-set spin lock kept deliberately tiny, because the
+// guarded sections (bump-pointer and free-list updates) are a handful of instructions
+struct spin_lock {
+  struct lock_type {
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+  };
+
+  struct guard {
+    explicit guard(lock_type &l) : _l(l) {
+      while (_l.flag.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    ~guard() { _l.flag.clear(std::memory_order_release); }
+
+   private:
+    lock_type &_l;
+  };
+};
+
+#endif
@@ -1,14 +1,44 @@
 #ifndef _LOG_TRAITS_H_
 #define _LOG_TRAITS_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-struct non_log {
+// Aggregate counters kept by the stats_log policy
+struct alloc_stats {
+  std::size_t allocations{0};
+  std::size_t deallocations{0};
+  std::size_t bytes_committed{0};
+  std::size_t extend_hits{0};    // extend_allocation grew the area in place
+  std::size_t extend_misses{0};  // caller had to fall back to allocate-and-copy (_M_realloc_insert path)
+  std::size_t peak_occupied_slots{0};
+};
+
+// Counter hooks called by mem_pool on its hot paths; no-ops unless the policy overrides them,
+// so non-counting policies cost nothing
+struct log_hooks {
+  static void on_allocate(std::size_t) {}
+  static void on_deallocate(std::size_t) {}
+  static void on_commit(std::size_t) {}
+  static void on_extend(bool) {}
+  static void on_occupied(std::size_t) {}
+};
+
+struct non_log : log_hooks {
   // func_name == __PRETTY_FUNCTION__
   static void log_line(const char *, std::size_t * = nullptr) {}
 };
 
-struct cout_log {
+struct cout_log : log_hooks {
   // func_name == __PRETTY_FUNCTION__
   static void log_line(const char *func_name, std::size_t *n = nullptr) {
     if (n)
@@ -18,7 +48,260 @@ struct cout_log {
   }
 };
 
-// TODO: file logging
+// Counting policy: silent like non_log, but keeps cheap aggregate counters readable through
+// page_allocator::stats(). The counters are shared by every pool instantiated with this policy
+// (plain increments - exact under one thread, approximate under many).
+struct stats_log : non_log {
+  static alloc_stats &stats() {
+    static alloc_stats instance;
+    return instance;
+  }
+
+  static void reset() { stats() = alloc_stats{}; }
+
+  static void on_allocate(std::size_t) { ++stats().allocations; }
+  static void on_deallocate(std::size_t) { ++stats().deallocations; }
+  static void on_commit(std::size_t bytes) { stats().bytes_committed += bytes; }
+  static void on_extend(bool hit) { hit ? ++stats().extend_hits : ++stats().extend_misses; }
+  static void on_occupied(std::size_t slots) {
+    if (slots > stats().peak_occupied_slots) stats().peak_occupied_slots = slots;
+  }
+};
+
+// Asynchronous file logging: the hot path only writes a {function-name pointer, size argument} record into a
+// lock-free single-producer/single-consumer ring buffer of its thread; a background writer thread drains all
+// rings every millisecond and binary-encodes them into "ak_alloc_trace.bin". Function names are emitted once
+// (a definition record with a small id), events then carry just the id and the size argument, so nothing is
+// formatted on the allocator's path and the trace is decoded offline.
+//
+// Record layout (little-endian, native widths):
+//   tag 1 (definition): uint8 tag, uint32 id, uint16 len, len bytes of the function name
+//   tag 2 (event):      uint8 tag, uint32 id, uint64 n   (n == UINT64_MAX when log_line got no size argument)
+struct file_log : log_hooks {
+  struct record {
+    const char *func;
+    std::uint64_t n;
+  };
+
+  // One producer (the owning thread), one consumer (the writer thread). When the ring is full the
+  // record is dropped rather than stalling the allocator.
+  struct ring {
+    static constexpr std::size_t capacity = 1u << 14;
+    record slots[capacity];
+    std::atomic<std::size_t> head{0};  // next slot to write, touched only by the producer
+    std::atomic<std::size_t> tail{0};  // next slot to read, touched only by the writer
+
+    bool push(const char *func, std::uint64_t n) {
+      std::size_t h = head.load(std::memory_order_relaxed);
+      if (h - tail.load(std::memory_order_acquire) >= capacity) return false;
+      slots[h % capacity] = {func, n};
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+  };
+
+  struct registry {
+    std::mutex mtx;              // guards rings registration only, never the hot path
+    std::vector<ring *> rings;   // one per producer thread; leaked on purpose so the writer can outlive producers
+    std::FILE *out{nullptr};
+    std::atomic<bool> stop{false};
+    std::thread writer;
+
+    registry() {
+      out = std::fopen("ak_alloc_trace.bin", "wb");
+      writer = std::thread([this] { run(); });
+    }
+
+    ~registry() {
+      stop.store(true, std::memory_order_release);
+      writer.join();
+      if (out) std::fclose(out);
+    }
+
+    void run() {
+      std::unordered_map<const char *, std::uint32_t> ids;
+      while (true) {
+        bool last_round = stop.load(std::memory_order_acquire);
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          for (ring *r : rings) drain(r, ids);
+        }
+        if (last_round) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      if (out) std::fflush(out);
+    }
+
+    void drain(ring *r, std::unordered_map<const char *, std::uint32_t> &ids) {
+      std::size_t h = r->head.load(std::memory_order_acquire);
+      std::size_t t = r->tail.load(std::memory_order_relaxed);
+      for (; t != h; ++t) {
+        record rec = r->slots[t % ring::capacity];
+        auto it = ids.find(rec.func);
+        if (it == ids.end()) {
+          it = ids.emplace(rec.func, static_cast<std::uint32_t>(ids.size())).first;
+          std::uint8_t tag = 1;
+          std::uint16_t len = static_cast<std::uint16_t>(std::strlen(rec.func));
+          std::fwrite(&tag, sizeof(tag), 1, out);
+          std::fwrite(&it->second, sizeof(it->second), 1, out);
+          std::fwrite(&len, sizeof(len), 1, out);
+          std::fwrite(rec.func, 1, len, out);
+        }
+        std::uint8_t tag = 2;
+        std::fwrite(&tag, sizeof(tag), 1, out);
+        std::fwrite(&it->second, sizeof(it->second), 1, out);
+        std::fwrite(&rec.n, sizeof(rec.n), 1, out);
+      }
+      r->tail.store(t, std::memory_order_release);
+    }
+
+    static registry &instance() {
+      static registry inst;
+      return inst;
+    }
+  };
+
+  static ring &my_ring() {
+    static thread_local ring *r = [] {
+      ring *fresh = new ring;  // never deleted: the writer may still drain it after the thread exits
+      registry &reg = registry::instance();
+      std::lock_guard<std::mutex> lock(reg.mtx);
+      reg.rings.push_back(fresh);
+      return fresh;
+    }();
+    return *r;
+  }
+
+  // func_name == __PRETTY_FUNCTION__
+  static void log_line(const char *func_name, std::size_t *n = nullptr) {
+    my_ring().push(func_name, n ? static_cast<std::uint64_t>(*n) : UINT64_MAX);
+  }
+};
+
+// Timestamped tracing: file_log's ring/writer machinery with an rdtsc timestamp and the producing thread's id
+// on every event, written to "ak_alloc_trace_tsc.bin". log_line fires at the top of every mem_pool function, so
+// the trace attributes commit (checked_range_commit), allocation and extend activity to the pool type that
+// caused it - __PRETTY_FUNCTION__ carries the full template signature, i.e. the element type and the policy
+// set. Decode with the trace_decode tool (tools/trace_decode.cpp) into Chrome trace-event JSON, loadable in
+// chrome://tracing / Perfetto and from there into flamegraphs.
+//
+// Record layout (little-endian, native widths):
+//   tag 1 (definition): uint8 tag, uint32 id, uint16 len, len bytes of the function name
+//   tag 3 (event):      uint8 tag, uint32 id, uint32 tid, uint64 tsc, uint64 n (UINT64_MAX = no size argument)
+struct trace_log : log_hooks {
+  struct record {
+    const char *func;
+    std::uint64_t tsc;
+    std::uint64_t n;
+  };
+
+  static std::uint64_t rdtsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+  }
+
+  // Same single-producer/single-consumer discipline as file_log::ring; full ring drops the record
+  struct ring {
+    static constexpr std::size_t capacity = 1u << 14;
+    record slots[capacity];
+    std::uint32_t tid{0};  // producing thread, stamped at registration
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> tail{0};
+
+    bool push(const char *func, std::uint64_t n) {
+      std::size_t h = head.load(std::memory_order_relaxed);
+      if (h - tail.load(std::memory_order_acquire) >= capacity) return false;
+      slots[h % capacity] = {func, rdtsc(), n};
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+  };
+
+  struct registry {
+    std::mutex mtx;
+    std::vector<ring *> rings;
+    std::FILE *out{nullptr};
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint32_t> next_tid{1};
+    std::thread writer;
+
+    registry() {
+      out = std::fopen("ak_alloc_trace_tsc.bin", "wb");
+      writer = std::thread([this] { run(); });
+    }
+
+    ~registry() {
+      stop.store(true, std::memory_order_release);
+      writer.join();
+      if (out) std::fclose(out);
+    }
+
+    void run() {
+      std::unordered_map<const char *, std::uint32_t> ids;
+      while (true) {
+        bool last_round = stop.load(std::memory_order_acquire);
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          for (ring *r : rings) drain(r, ids);
+        }
+        if (last_round) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      if (out) std::fflush(out);
+    }
+
+    void drain(ring *r, std::unordered_map<const char *, std::uint32_t> &ids) {
+      std::size_t h = r->head.load(std::memory_order_acquire);
+      std::size_t t = r->tail.load(std::memory_order_relaxed);
+      for (; t != h; ++t) {
+        record rec = r->slots[t % ring::capacity];
+        auto it = ids.find(rec.func);
+        if (it == ids.end()) {
+          it = ids.emplace(rec.func, static_cast<std::uint32_t>(ids.size())).first;
+          std::uint8_t tag = 1;
+          std::uint16_t len = static_cast<std::uint16_t>(std::strlen(rec.func));
+          std::fwrite(&tag, sizeof(tag), 1, out);
+          std::fwrite(&it->second, sizeof(it->second), 1, out);
+          std::fwrite(&len, sizeof(len), 1, out);
+          std::fwrite(rec.func, 1, len, out);
+        }
+        std::uint8_t tag = 3;
+        std::fwrite(&tag, sizeof(tag), 1, out);
+        std::fwrite(&it->second, sizeof(it->second), 1, out);
+        std::fwrite(&r->tid, sizeof(r->tid), 1, out);
+        std::fwrite(&rec.tsc, sizeof(rec.tsc), 1, out);
+        std::fwrite(&rec.n, sizeof(rec.n), 1, out);
+      }
+      r->tail.store(t, std::memory_order_release);
+    }
+
+    static registry &instance() {
+      static registry inst;
+      return inst;
+    }
+  };
+
+  static ring &my_ring() {
+    static thread_local ring *r = [] {
+      ring *fresh = new ring;  // never deleted: the writer may still drain it after the thread exits
+      registry &reg = registry::instance();
+      fresh->tid = reg.next_tid.fetch_add(1, std::memory_order_relaxed);
+      std::lock_guard<std::mutex> lock(reg.mtx);
+      reg.rings.push_back(fresh);
+      return fresh;
+    }();
+    return *r;
+  }
+
+  // func_name == __PRETTY_FUNCTION__
+  static void log_line(const char *func_name, std::size_t *n = nullptr) {
+    my_ring().push(func_name, n ? static_cast<std::uint64_t>(*n) : UINT64_MAX);
+  }
+};
+
 // TODO: printf logging
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,85 @@
+#ifndef _OFFSET_PTR_H_
+#define _OFFSET_PTR_H_
+
+#include <cstddef>
+
+namespace ak_allocator {
+
+/**
+ * Self-relative pointer for records inside a shared pool (init_shm_pool): the stored value is the distance from the
+ * offset_ptr object itself to the pointee, so it means the same thing in every process, no matter where each one's
+ * mmap placed the segment. Raw pointers, in contrast, are only valid in the mapping that produced them.
+ *
+ * This is the groundwork type for fancy-pointer support: it satisfies the NullablePointer-style surface that
+ * __gnu_cxx::__alloc_traits expects from an allocator's pointer typedef. Offset 0 plays nullptr, so an offset_ptr
+ * can not point at itself.
+ */
+template <typename _Tp>
+class offset_ptr {
+ public:
+  using element_type = _Tp;
+  using difference_type = std::ptrdiff_t;
+
+  template <typename _Tp1>
+  struct rebind {
+    using other = offset_ptr<_Tp1>;
+  };
+
+  offset_ptr() noexcept = default;
+  offset_ptr(std::nullptr_t) noexcept {}
+  offset_ptr(_Tp *__p) noexcept { set(__p); }
+
+  // relocating an offset_ptr changes what "self-relative" is relative to, so every copy recomputes the offset
+  offset_ptr(const offset_ptr &__other) noexcept { set(__other.get()); }
+
+  offset_ptr &operator=(const offset_ptr &__other) noexcept {
+    set(__other.get());
+    return *this;
+  }
+
+  offset_ptr &operator=(_Tp *__p) noexcept {
+    set(__p);
+    return *this;
+  }
+
+  _Tp *get() const noexcept { return _off == 0 ? nullptr : reinterpret_cast<_Tp *>(const_cast<char *>(reinterpret_cast<const char *>(this)) + _off); }
+
+  _Tp &operator*() const noexcept { return *get(); }
+  _Tp *operator->() const noexcept { return get(); }
+  _Tp &operator[](difference_type __i) const noexcept { return get()[__i]; }
+
+  explicit operator bool() const noexcept { return _off != 0; }
+
+  offset_ptr &operator+=(difference_type __n) noexcept {
+    set(get() + __n);
+    return *this;
+  }
+
+  offset_ptr &operator-=(difference_type __n) noexcept {
+    set(get() - __n);
+    return *this;
+  }
+
+  offset_ptr &operator++() noexcept { return *this += 1; }
+  offset_ptr &operator--() noexcept { return *this -= 1; }
+
+  friend bool operator==(const offset_ptr &__a, const offset_ptr &__b) noexcept { return __a.get() == __b.get(); }
+  friend bool operator!=(const offset_ptr &__a, const offset_ptr &__b) noexcept { return __a.get() != __b.get(); }
+  friend bool operator==(const offset_ptr &__a, std::nullptr_t) noexcept { return __a.get() == nullptr; }
+  friend bool operator!=(const offset_ptr &__a, std::nullptr_t) noexcept { return __a.get() != nullptr; }
+  friend difference_type operator-(const offset_ptr &__a, const offset_ptr &__b) noexcept { return __a.get() - __b.get(); }
+
+  static offset_ptr pointer_to(_Tp &__r) noexcept { return offset_ptr(&__r); }
+
+ private:
+  void set(const _Tp *__p) noexcept {
+    _off = __p == nullptr ? 0 : reinterpret_cast<const char *>(__p) - reinterpret_cast<const char *>(this);
+  }
+
+  // distance from this object to the pointee; 0 = null
+  difference_type _off{0};
+};
+
+}  // namespace ak_allocator
+
+#endif
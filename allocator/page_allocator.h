@@ -3,69 +3,172 @@
 
 #include <bits/c++config.h>
 
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lock_traits.h"
 #include "log_traits.h"
+#include "pool_traits.h"
 
 extern "C" {
-#include <sys/mman.h>  // mmap, mprotect
-#include <unistd.h>    // sysconf
+#include <fcntl.h>        // open
+#include <sys/mman.h>     // mmap, mprotect, madvise, msync, shm_open
+#include <sys/stat.h>     // fstat
+#include <sys/syscall.h>  // SYS_mbind
+#include <unistd.h>       // sysconf, syscall, ftruncate, close
 }
 
+// Huge-page mmap flags are missing from older kernel headers
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+
+// mbind goes through syscall() - linking libnuma for one call is not worth it - and numaif.h may be absent
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+
 namespace ak_allocator {
 
 namespace __detail {
 
-template <typename _Tp, typename Logger>
+// Background commit-ahead service shared by every pool running with PoolCfg::use_async_commit (one worker
+// thread per process, like file_log's trace writer). A pool posts the overshoot range of a commit as a task;
+// the worker mprotects it in small strides and prefaults the pages, staying ahead of the pool's write cursor.
+// The worker only ever makes pages MORE available, and the pools' synchronous commit path stays intact, so a
+// lost race costs a redundant mprotect, never correctness.
+struct async_committer {
+  struct commit_task {
+    std::atomic<std::uint64_t> from{0};  // next byte the worker will commit
+    std::atomic<std::uint64_t> to{0};    // commit goal (exclusive); from >= to means idle
+    int pagesize{0};
+  };
+
+  std::mutex mtx;                    // guards the task list and serializes worker strides against task parking
+  std::vector<commit_task *> tasks;  // leaked on purpose, so the worker can outlive any single pool
+  std::atomic<bool> stop{false};
+  std::thread worker;
+
+  async_committer() {
+    worker = std::thread([this] { run(); });
+  }
+
+  ~async_committer() {
+    stop.store(true, std::memory_order_release);
+    worker.join();
+  }
+
+  void run() {
+    while (!stop.load(std::memory_order_acquire)) {
+      bool busy = false;
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (commit_task *task : tasks) busy |= step(task);
+      }
+      if (!busy) std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }
+
+  // commits at most a small stride of the task's pending range, so the mutex is never held long
+  bool step(commit_task *task) {
+    std::uint64_t from = task->from.load(std::memory_order_relaxed);
+    std::uint64_t to = task->to.load(std::memory_order_acquire);
+    if (from >= to) return false;
+
+    std::uint64_t end = from + 16u * task->pagesize;
+    if (end > to) end = to;
+    // best effort: a failure here just leaves the range for the pool's synchronous path
+    if (mprotect(reinterpret_cast<void *>(from), end - from, PROT_READ | PROT_WRITE) == 0) {
+#ifdef MADV_POPULATE_WRITE
+      // fault the pages in now, so the writer pays neither the protection change nor the first-touch fault
+      madvise(reinterpret_cast<void *>(from), end - from, MADV_POPULATE_WRITE);
+#endif
+    }
+    task->from.store(end, std::memory_order_release);
+    return true;
+  }
+
+  static async_committer &instance() {
+    static async_committer inst;
+    return inst;
+  }
+};
+
+template <typename _Tp, typename Logger, typename Locker = no_lock, typename PoolCfg = pool_defaults>
 struct mem_pool {
   using elem_type = typename std::aligned_storage<sizeof(_Tp), alignof(_Tp)>::type;
 
   mem_pool() = default;
 
-  mem_pool(const mem_pool &other) noexcept
-      : pages_mmaped(other.pages_mmaped), occupied_slots(other.occupied_slots), free_slots_left(other.free_slots_left), pagesize(other.pagesize) {
+  // Copies are lazy: a copy shares no memory with the original, so it starts with an empty pool and only
+  // mmaps on its first get_allocation (which already handles begin_gp == nullptr). Copying a container
+  // therefore costs no syscall until the copy actually allocates. Only the sizing hint is carried over.
+  mem_pool(const mem_pool &other) noexcept : pages_hint(other.pages_mmaped ? other.pages_mmaped : other.pages_hint), pagesize(other.pagesize) {
     Logger::log_line(__PRETTY_FUNCTION__);
-    init_pool(pages_mmaped);
   }
 
   // Conversion copy Ctor
   template <typename _Tp1>
-  explicit mem_pool(const mem_pool<_Tp1, Logger> &other) noexcept
-      : pages_mmaped(other.pages_mmaped), occupied_slots(other.occupied_slots), free_slots_left(other.free_slots_left), pagesize(other.pagesize) {
+  explicit mem_pool(const mem_pool<_Tp1, Logger, Locker, PoolCfg> &other) noexcept
+      : pages_hint(other.pages_mmaped ? other.pages_mmaped : other.pages_hint), pagesize(other.pagesize) {
     Logger::log_line(__PRETTY_FUNCTION__);
-    init_pool(pages_mmaped);
   }
 
+  // NOTE: the inline tier (inline_buf/inline_used) deliberately stays behind on a move - its slots live at the old
+  // object's address, so live inline allocations cannot survive a move anyway (see pool_traits.h)
   explicit mem_pool(mem_pool &&rhs) noexcept
       : begin_gp(rhs.begin_gp),
         end_gp(rhs.end_gp),
         allocation_area(rhs.allocation_area),
         first_not_commited(rhs.first_not_commited),
+        free_list(rhs.free_list),
+        owner(rhs.owner.load(std::memory_order_relaxed)),
+        remote_free(rhs.remote_free.load(std::memory_order_relaxed)),
+        retired(rhs.retired),
         pages_mmaped(rhs.pages_mmaped),
         occupied_slots(rhs.occupied_slots),
         free_slots_left(rhs.free_slots_left),
-        pagesize(rhs.pagesize) {
+        pool_epoch(rhs.pool_epoch),
+        pages_hint(rhs.pages_hint),
+        pagesize(rhs.pagesize),
+        backing_fd(rhs.backing_fd),
+        async_task(rhs.async_task) {
     Logger::log_line(__PRETTY_FUNCTION__);
 
     rhs.begin_gp = nullptr;
     rhs.end_gp = nullptr;
     rhs.allocation_area = nullptr;
     rhs.first_not_commited = nullptr;
+    rhs.free_list = nullptr;
+    rhs.owner.store(std::thread::id{}, std::memory_order_relaxed);
+    rhs.remote_free.store(nullptr, std::memory_order_relaxed);
+    rhs.retired = nullptr;
 
     rhs.pages_mmaped = 0;
     rhs.occupied_slots = 0;
     rhs.free_slots_left = 0;
     rhs.pagesize = 0;
+    rhs.backing_fd = -1;
+    rhs.async_task = nullptr;
   }
 
   mem_pool &operator=(const mem_pool &other) {
     Logger::log_line(__PRETTY_FUNCTION__);
     deinit_pool();
 
-    pages_mmaped = other.pages_mmaped;
-    occupied_slots = other.occupied_slots;
-    free_slots_left = other.free_slots_left;
+    // lazy, like the copy Ctor: drop to the empty state and let the first get_allocation map the pool
+    pages_hint = other.pages_mmaped ? other.pages_mmaped : other.pages_hint;
     pagesize = other.pagesize;
-
-    init_pool(pages_mmaped);
     return *this;
   }
 
@@ -75,21 +178,35 @@ struct mem_pool {
     end_gp = rhs.end_gp;
     allocation_area = rhs.allocation_area;
     first_not_commited = rhs.first_not_commited;
+    free_list = rhs.free_list;
+    owner.store(rhs.owner.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    remote_free.store(rhs.remote_free.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    retired = rhs.retired;
 
     pages_mmaped = rhs.pages_mmaped;
+    pages_hint = rhs.pages_hint;
     occupied_slots = rhs.occupied_slots;
     free_slots_left = rhs.free_slots_left;
+    pool_epoch = rhs.pool_epoch;
     pagesize = rhs.pagesize;
+    backing_fd = rhs.backing_fd;
+    async_task = rhs.async_task;
 
     rhs.begin_gp = nullptr;
     rhs.end_gp = nullptr;
     rhs.allocation_area = nullptr;
     rhs.first_not_commited = nullptr;
+    rhs.free_list = nullptr;
+    rhs.owner.store(std::thread::id{}, std::memory_order_relaxed);
+    rhs.remote_free.store(nullptr, std::memory_order_relaxed);
+    rhs.retired = nullptr;
 
     rhs.pages_mmaped = 0;
     rhs.occupied_slots = 0;
     rhs.free_slots_left = 0;
     rhs.pagesize = 0;
+    rhs.backing_fd = -1;
+    rhs.async_task = nullptr;
     return *this;
   }
 
@@ -97,7 +214,7 @@ struct mem_pool {
   void *begin_gp{nullptr};
 
   // Start address of the last guard page (unusable area) that follows the
-  // usable area
+  // usable area; in the guard-free layout it is one past the end of the mapping
   void *end_gp{nullptr};
 
   // Start address of the first element - this is the first properly aligned for _Tp address in the usable area of the buffer (the first properly aligned
@@ -107,6 +224,78 @@ struct mem_pool {
   // First reserved, but not committed page
   void *first_not_commited{nullptr};
 
+  // Node of the free list; nodes are stored in-place inside the freed slots themselves, so the list costs no extra memory.
+  // A node describes a contiguous run of free slots starting at the node's own address.
+  struct free_node {
+    free_node *next;
+    std::size_t slots;
+  };
+
+  // An in-place node inherits the alignment of the slot it is built in, which may be weaker than free_node's own
+  // (an int pool aligns slots to 4); a run starting at such an address can't carry a node
+  static bool node_aligned(const void *ptr) { return reinterpret_cast<std::uintptr_t>(ptr) % alignof(free_node) == 0; }
+
+  // Head of the list of freed interior runs available for reuse by get_allocation
+  free_node *free_list{nullptr};
+
+  // Thread that owns the pool (the one that ran init_pool); only it may touch the members above. delete_allocation
+  // reads it lock-free to route foreign frees while init/grow/deinit rewrite it under the guard - hence atomic.
+  std::atomic<std::thread::id> owner{};
+
+  // MPSC remote-free queue (a Treiber stack of free_nodes built inside the freed slots): foreign threads push their
+  // delete_allocation calls here, the owner drains the stack at the top of get_allocation
+  std::atomic<free_node *> remote_free{nullptr};
+
+  // Inline small-buffer tier (PoolCfg::inline_slots > 0): a handful of slots embedded in the pool object itself and
+  // served before any mmap'd memory, so small containers never reach the kernel. Occupancy is one bit per slot in
+  // inline_used. The storage specialization keeps the default (disabled) pool free of the array.
+  template <std::size_t _Slots, bool = (_Slots != 0)>
+  struct inline_storage {
+    elem_type slots[_Slots];
+  };
+  template <std::size_t _Slots>
+  struct inline_storage<_Slots, false> {};
+
+  static constexpr std::size_t inline_slots = PoolCfg::inline_slots;
+  static_assert(inline_slots <= 64, "the inline tier tracks occupancy in a single 64-bit mask");
+
+  inline_storage<inline_slots> inline_buf;
+  std::uint64_t inline_used{0};
+
+  // Quarantine of recently freed runs (PoolCfg::quarantine_depth > 0): a freed run is parked in this ring and only
+  // goes through the real free path when it is evicted by a younger one, so stale pointers keep hitting poisoned
+  // (or, under the fence layout, protected) memory instead of recycled data. Parked runs still count as occupied.
+  struct quarantined_run {
+    void *ptr;
+    std::size_t slots;
+  };
+  template <std::size_t _Depth, bool = (_Depth != 0)>
+  struct quarantine_storage {
+    quarantined_run runs[_Depth];
+  };
+  template <std::size_t _Depth>
+  struct quarantine_storage<_Depth, false> {};
+
+  static constexpr std::size_t quarantine_depth = PoolCfg::quarantine_depth;
+
+  quarantine_storage<quarantine_depth> quarantine;
+  std::size_t quarantine_next{0};
+  std::size_t quarantine_count{0};
+
+  // A previous, fully-exhausted mapping that still holds live allocations. When the pool grows it switches to a fresh,
+  // bigger mapping and keeps the old one on this chain until its last allocation is deleted.
+  struct segment {
+    segment *next;
+    void *begin_gp;
+    void *end_gp;
+    elem_type *allocation_area;
+    std::size_t pages_mmaped;
+    std::size_t live_slots;
+  };
+
+  // Head of the chain of retired mappings (most recently retired first)
+  segment *retired{nullptr};
+
   // Number of pages that have been obtained by the last mmap call to the system
   std::size_t pages_mmaped{0};
 
@@ -117,28 +306,115 @@ struct mem_pool {
   // Number of free slots available in the allocation_area
   std::size_t free_slots_left{0};
 
-  // Default size of the usable for allocation area of the pool's memory (1 MB = 256 pages per 4096 bytes, just to be)
-  const std::size_t allocate_pgs{256};
+  // Generation counter, bumped by every reset(): a handle stamped with the epoch it was allocated under can be
+  // checked against the current value in debug builds to catch use across an arena rewind
+  std::size_t pool_epoch{0};
+
+  // Default size of the pool's first mapping in pages, from PoolCfg (256 pages = 1 MB per 4096 bytes).
+  // A compile-time constant now: it costs no per-pool storage and the sizing math folds away.
+  static constexpr std::size_t allocate_pgs = PoolCfg::pool_pages;
+  static_assert(allocate_pgs > 2 * (PoolCfg::use_guard_pages ? 1 : 0), "the pool needs at least one usable page besides the guards");
+
+  // Sizing carried over from a copied-from pool: the number of pages the lazy first init_pool should map (0 = allocate_pgs)
+  std::size_t pages_hint{0};
 
   // System page size
   int pagesize{0};
 
+  // File descriptor behind a file-backed pool (init_file_pool); -1 for the normal anonymous mapping
+  int backing_fd{-1};
+
+  // This pool's entry in the commit-ahead service (PoolCfg::use_async_commit); created on the first posted range
+  async_committer::commit_task *async_task{nullptr};
+
+  // Pages spent on one guard (per side of the usable area); 0 in the guard-free layout
+  static constexpr std::size_t guard_pgs = PoolCfg::use_guard_pages ? 1 : 0;
+
+  // Lock state of the Locker policy; empty (and never touched) for no_lock.
+  // Deliberately not part of copy/move: a lock identifies one pool instance.
+  mutable typename Locker::lock_type pool_lock;
+
   /**
    * @brief The function checks if the @ptr belongs to its mapping
    *
    * @param ptr     pointer to check
    * @return true   the pointer belongs to the mapping of this class
    * @return false  the pointer DO NOT belongs to the mapping of this class
+   *
+   * The fast path is two pointer compares against the usable area [allocation_area, end_gp) of the active mapping
+   * (the old `val > allocation_area && val < begin_gp` comparison was inverted - begin_gp sits *below* the usable
+   * area - and also excluded the first slot, so it never matched). Only on a miss is the retired chain walked.
    */
   bool owns(void *val) {
     Logger::log_line(__PRETTY_FUNCTION__);
-    bool retValue = false;
-    if (val > allocation_area && val < begin_gp) retValue = true;
-    return retValue;
+    if constexpr (inline_slots != 0)
+      if (inline_owns(val)) return true;
+    if (val >= static_cast<void *>(allocation_area) && val < end_gp) return true;
+    return find_retired(val) != nullptr;
+  }
+
+  /**
+   * @brief Locked read of the watermark for callers that don't hold the pool guard (the _MaxObjects throttle in
+   * page_allocator::allocate); under no_lock this compiles down to the plain load it replaces.
+   */
+  std::size_t occupied() const {
+    typename Locker::guard lock(pool_lock);
+    return occupied_slots;
+  }
+
+  /**
+   * @brief The function walks the retired chain looking for the segment whose usable area contains @val
+   *
+   * @param val  pointer to look up
+   * @return     address of the owning chain link (so the caller can unlink the segment), nullptr when no retired
+   *             segment owns the pointer.
+   */
+  segment **find_retired(void *val) {
+    for (segment **link = &retired; *link != nullptr; link = &(*link)->next)
+      if (val >= static_cast<void *>((*link)->allocation_area) && val < (*link)->end_gp) return link;
+    return nullptr;
+  }
+
+  elem_type *inline_begin() { return inline_buf.slots; }
+
+  // mask with bit set for every slot of a run of @nmbr slots (shift it to the run's position)
+  static std::uint64_t inline_mask(std::size_t nmbr) { return (nmbr >= 64) ? ~std::uint64_t{0} : ((std::uint64_t{1} << nmbr) - 1); }
+
+  bool inline_owns(const void *val) const {
+    return val >= static_cast<const void *>(inline_buf.slots) && val < static_cast<const void *>(inline_buf.slots + inline_slots);
+  }
+
+  /**
+   * @brief The function serves @nmbr slots from the inline buffer (first fit over the occupancy mask)
+   *
+   * @param nmbr  the number of slots needed;
+   * @return  pointer to the run inside the pool object itself; nullptr when the buffer can't hold the run.
+   */
+  void *inline_get(std::size_t nmbr) {
+    if (nmbr == 0 || nmbr > inline_slots) return nullptr;
+    std::uint64_t run = inline_mask(nmbr);
+    for (std::size_t pos = 0; pos + nmbr <= inline_slots; ++pos)
+      if ((inline_used & (run << pos)) == 0) {
+        inline_used |= run << pos;
+        Logger::on_allocate(nmbr);
+        return inline_begin() + pos;
+      }
+    return nullptr;
+  }
+
+  // returns an inline run to the mask; the caller has checked inline_owns(ptr)
+  bool inline_delete(void *ptr, std::size_t nmbr) {
+    std::size_t pos = static_cast<std::size_t>(reinterpret_cast<elem_type *>(ptr) - inline_begin());
+    inline_used &= ~(inline_mask(nmbr) << pos);
+    Logger::on_deallocate(nmbr);
+    return true;
   }
 
   int set_pagesize() {
-    pagesize = sysconf(_SC_PAGE_SIZE);
+    if constexpr (PoolCfg::use_huge_pages)
+      pagesize = static_cast<int>(PoolCfg::huge_page_size);
+    else
+      pagesize = sysconf(_SC_PAGE_SIZE);
     std::size_t log_ps = static_cast<std::size_t>(pagesize);
     Logger::log_line(__PRETTY_FUNCTION__, &log_ps);
     return pagesize;
@@ -153,13 +429,13 @@ struct mem_pool {
    */
   bool commit_page(void *pg) {
     Logger::log_line(__PRETTY_FUNCTION__);
-    if (reinterpret_cast<uint64_t>(pg) < (reinterpret_cast<uint64_t>(begin_gp) + pagesize) ||
-        reinterpret_cast<uint64_t>(pg) > reinterpret_cast<uint64_t>(end_gp))
+    if (reinterpret_cast<uint64_t>(pg) < reinterpret_cast<uint64_t>(allocation_area) || reinterpret_cast<uint64_t>(pg) >= reinterpret_cast<uint64_t>(end_gp))
       return false;
 
     if (mprotect(pg, pagesize, PROT_READ | PROT_WRITE) == -1)
       return false;
     else {
+      Logger::on_commit(pagesize);
       first_not_commited = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(pg) + pagesize);
       return true;
     }
@@ -172,20 +448,202 @@ struct mem_pool {
    * @return true   OK
    * @return false  Can't commit one or more pages
    *
-   * If the function fails to commit a page, then it recovers first_not_commited (set to one past last succesfully commited page).
+   * The whole needed range is committed with a single mprotect call instead of one call per page. On top of that the
+   * commit overshoots: it asks for twice the needed length (clamped to the usable area), mirroring vector capacity
+   * growth, so a run of push_back-driven extend_allocation calls lands on already-commited pages and pays no syscall.
+   * When the overshooting mprotect fails the function retries with exactly the needed range before giving up.
    */
   bool checked_range_commit(void *pg) {
     Logger::log_line(__PRETTY_FUNCTION__);
-    bool retVal = true;
-    if (pg > first_not_commited) {
-      void *page_to_commit = first_not_commited;
-      while (page_to_commit < pg) {
-        retVal = commit_page(page_to_commit);
-        if (!retVal) break;
-        page_to_commit = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(page_to_commit) + pagesize);
+    if (pg < first_not_commited) return true;
+
+    uint64_t base = reinterpret_cast<uint64_t>(first_not_commited);
+    uint64_t limit = reinterpret_cast<uint64_t>(end_gp);
+
+    // round the needed end up to a page boundary
+    uint64_t need_end = reinterpret_cast<uint64_t>(pg) + 1;
+    need_end = ((need_end + pagesize - 1) / pagesize) * pagesize;
+    if (need_end > limit) return false;
+
+    uint64_t want_end = need_end + (need_end - base);
+    if (want_end > limit) want_end = limit;
+
+    if constexpr (PoolCfg::use_async_commit) {
+      // commit only what the caller needs now and hand the overshoot to the background committer, which walks
+      // ahead of the write cursor. first_not_commited stays at the synchronous end: if the writer overtakes the
+      // worker this path just mprotects the already-committed stretch again (idempotent), so a lost race costs
+      // a redundant syscall, never a fault.
+      if (mprotect(first_not_commited, need_end - base, PROT_READ | PROT_WRITE) == -1) return false;
+      Logger::on_commit(need_end - base);
+      first_not_commited = reinterpret_cast<void *>(need_end);
+      if (want_end > need_end) post_async(need_end, want_end);
+      return true;
+    }
+
+    if (mprotect(first_not_commited, want_end - base, PROT_READ | PROT_WRITE) == -1) {
+      if (want_end == need_end || mprotect(first_not_commited, need_end - base, PROT_READ | PROT_WRITE) == -1) return false;
+      want_end = need_end;
+    }
+    Logger::on_commit(want_end - base);
+    first_not_commited = reinterpret_cast<void *>(want_end);
+    return true;
+  }
+
+  /**
+   * @brief The function hands the range [@from, @to) of the active mapping to the background committer
+   *
+   * @param from  first byte of the range (page aligned - the end of the synchronously committed stretch);
+   * @param to    one past the last byte, already clamped to the usable area.
+   *
+   * The pool's task is created (and registered with the service) on the first post. Later posts update the task's
+   * atomics without the service mutex: the goal is parked to 0 first and published last, and the worker's own
+   * frontier store can only ever re-aim it at pages of the same live mapping, so the worst a race does is commit
+   * an already-committed stretch again. Only retiring the mapping needs real exclusion - see async_reset.
+   */
+  void post_async(std::uint64_t from, std::uint64_t to) {
+    async_committer &svc = async_committer::instance();
+    if (async_task == nullptr) {
+      async_task = new async_committer::commit_task;
+      async_task->pagesize = pagesize;
+      std::lock_guard<std::mutex> lock(svc.mtx);
+      svc.tasks.push_back(async_task);
+    }
+    async_task->to.store(0, std::memory_order_relaxed);
+    async_task->from.store(from, std::memory_order_relaxed);
+    async_task->to.store(to, std::memory_order_release);
+  }
+
+  /**
+   * @brief The function parks this pool's commit task so the worker can no longer touch the mapping
+   *
+   * Must run before the active mapping is munmaped, retired or re-protected. Taking the service mutex waits out
+   * any stride the worker is in the middle of; afterwards the parked task commits nothing until the next
+   * post_async. The (leaked) task object stays registered for the pool's next mapping.
+   */
+  void async_reset() {
+    if (async_task == nullptr) return;
+    std::lock_guard<std::mutex> lock(async_committer::instance().mtx);
+    async_task->to.store(0, std::memory_order_relaxed);
+    async_task->from.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief The function returns the committed-but-unused tail of the pool to the OS without touching the mapping
+   *
+   * @return true   the tail has been decommited (or there was nothing to give back);
+   * @return false  the pool is not initialized or the tail can't be re-protected.
+   *
+   * Pages wholly above the occupied_slots watermark and below first_not_commited are marked MADV_FREE (the kernel
+   * reclaims them lazily, and only under pressure) and re-protected PROT_NONE so the lazy-commit invariant of
+   * first_not_commited stays intact. The first usable page always stays committed, matching init_pool. Interior
+   * free-list holes below the watermark are not touched.
+   */
+  bool decommit_tail() {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    typename Locker::guard lock(pool_lock);
+    if (begin_gp == nullptr) return false;
+    // giving pages back would reintroduce the faults the prefault contract paid to remove
+    if constexpr (PoolCfg::use_prefault) return true;
+    // the worker must not re-commit pages this function is about to protect away
+    if constexpr (PoolCfg::use_async_commit) async_reset();
+
+    uint64_t watermark = reinterpret_cast<uint64_t>(allocation_area + occupied_slots);
+    uint64_t tail_start = ((watermark + pagesize - 1) / pagesize) * pagesize;
+    uint64_t min_keep = reinterpret_cast<uint64_t>(allocation_area) + pagesize;
+    if (tail_start < min_keep) tail_start = min_keep;
+
+    uint64_t committed_end = reinterpret_cast<uint64_t>(first_not_commited);
+    if (tail_start >= committed_end) return true;
+
+#ifdef MADV_FREE
+    madvise(reinterpret_cast<void *>(tail_start), committed_end - tail_start, MADV_FREE);
+#else
+    madvise(reinterpret_cast<void *>(tail_start), committed_end - tail_start, MADV_DONTNEED);
+#endif
+    if (mprotect(reinterpret_cast<void *>(tail_start), committed_end - tail_start, PROT_NONE) == -1) return false;
+    first_not_commited = reinterpret_cast<void *>(tail_start);
+    return true;
+  }
+
+  /**
+   * @brief The function invalidates every outstanding allocation of the pool at once and rewinds it to empty
+   *
+   * @param release_pages  also return the committed pages to the OS (MADV_DONTNEED + re-protect), so the next
+   *                       epoch starts from zero-cost pages instead of the previous request's resident set;
+   * @return true          the pool is empty (also when it was never initialized);
+   * @return false         re-protecting the committed range failed.
+   *
+   * Arena-style teardown for per-request lifecycles: instead of walking delete_allocation per block, the
+   * watermark, free list, quarantine, inline tier and remote-free queue are dropped in O(1) and the retired
+   * chain is unmapped. The mapping itself stays, so the next request allocates without a fresh mmap. Every
+   * reset bumps pool_epoch; all pointers from earlier epochs are invalid (a debug build can stamp handles with
+   * the epoch and assert on use). A file-backed pool rewinds its watermark but keeps its pages - they are the
+   * file's contents.
+   */
+  bool reset(bool release_pages = false) {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    typename Locker::guard lock(pool_lock);
+
+    ++pool_epoch;
+    if constexpr (inline_slots != 0) inline_used = 0;
+    if constexpr (PoolCfg::quarantine_depth != 0) quarantine_next = quarantine_count = 0;
+    // parked nodes live in pool memory that is dying with this epoch - just forget the queue
+    remote_free.store(nullptr, std::memory_order_relaxed);
+
+    while (retired != nullptr) {
+      segment *seg = retired;
+      retired = seg->next;
+      munmap(seg->begin_gp, seg->pages_mmaped * pagesize);
+      delete seg;
+    }
+    if (begin_gp == nullptr) return true;
+
+    // interior holes sit below the watermark AND already on free_slots_left - count them once, not twice
+    std::size_t listed = 0;
+    for (free_node *node = free_list; node != nullptr; node = node->next) listed += node->slots;
+    free_list = nullptr;
+    // occupied + free_slots_left - listed is the usable total (the same arithmetic grow_pool uses for live slots)
+    free_slots_left += occupied_slots - listed;
+    occupied_slots = 0;
+
+    if constexpr (PoolCfg::use_async_commit) async_reset();
+    if constexpr (PoolCfg::use_fence_pages) {
+      // trap pages of the dead epoch would fault the next bump pass through the committed range
+      uint64_t base = reinterpret_cast<uint64_t>(begin_gp) + guard_pgs * pagesize;
+      uint64_t committed_end = reinterpret_cast<uint64_t>(first_not_commited);
+      if (committed_end > base && mprotect(reinterpret_cast<void *>(base), committed_end - base, PROT_READ | PROT_WRITE) == -1) return false;
+    }
+    if constexpr (PoolCfg::use_prefault) release_pages = false;  // the contract keeps its pages resident
+    if (release_pages && backing_fd < 0) {
+      uint64_t keep_end = reinterpret_cast<uint64_t>(allocation_area) + pagesize;  // first page stays, as after init_pool
+      uint64_t committed_end = reinterpret_cast<uint64_t>(first_not_commited);
+      if (keep_end < committed_end) {
+        madvise(reinterpret_cast<void *>(keep_end), committed_end - keep_end, MADV_DONTNEED);
+        if (mprotect(reinterpret_cast<void *>(keep_end), committed_end - keep_end, PROT_NONE) == -1) return false;
+        first_not_commited = reinterpret_cast<void *>(keep_end);
       }
+      madvise(allocation_area, pagesize, MADV_DONTNEED);
     }
-    return retVal;
+    return true;
+  }
+
+  /**
+   * @brief The function binds the mapping to the configured NUMA node, so commit_page faults allocate there
+   *
+   * @param addr  start of the mapping (as returned by mmap);
+   * @param len   length of the mapping in bytes.
+   *
+   * Best effort: on kernels without NUMA support (or a bad node id) the call fails and the pool silently keeps
+   * first-touch placement - wrong-node memory is a performance problem, not a correctness one.
+   */
+  static void bind_to_node(void *addr, std::size_t len) {
+#ifdef SYS_mbind
+    unsigned long nodemask = 1ul << PoolCfg::numa_node;
+    syscall(SYS_mbind, addr, len, MPOL_BIND, &nodemask, sizeof(nodemask) * 8, 0u);
+#else
+    (void)addr;
+    (void)len;
+#endif
   }
 
   /**
@@ -200,27 +658,212 @@ struct mem_pool {
     bool retValue = false;
     if (!pagesize && set_pagesize() == -1) return false;
     if (begin_gp != nullptr) return false;
-    if (!pgs) pgs = allocate_pgs;
-
-    begin_gp = mmap(NULL, pgs * pagesize, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (!pgs) pgs = pages_hint ? pages_hint : allocate_pgs;
+
+    if constexpr (PoolCfg::use_huge_pages) {
+      begin_gp = mmap(NULL, pgs * pagesize, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+      if (begin_gp == MAP_FAILED) {
+        // no hugetlb pool configured: fall back to a normal mapping and ask for transparent huge pages;
+        // the pool keeps committing in huge-page strides either way
+        begin_gp = mmap(NULL, pgs * pagesize, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+#ifdef MADV_HUGEPAGE
+        if (begin_gp != MAP_FAILED) madvise(begin_gp, pgs * pagesize, MADV_HUGEPAGE);
+#endif
+      }
+    } else
+      begin_gp = mmap(NULL, pgs * pagesize, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
     if (begin_gp == MAP_FAILED)
       retValue = false;
     else {
+      if constexpr (PoolCfg::numa_node >= 0) bind_to_node(begin_gp, pgs * pagesize);
       pages_mmaped = pgs;
-      allocation_area = reinterpret_cast<elem_type *>(reinterpret_cast<uint64_t>(begin_gp) + pagesize);
-      end_gp = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(begin_gp) + ((pages_mmaped - 1) * pagesize));
+      // with guards disabled the usable area is the whole mapping: end_gp then names one past its end
+      allocation_area = reinterpret_cast<elem_type *>(reinterpret_cast<uint64_t>(begin_gp) + (guard_pgs * pagesize));
+      end_gp = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(begin_gp) + ((pages_mmaped - guard_pgs) * pagesize));
       first_not_commited = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(allocation_area) + pagesize);
+      free_list = nullptr;
+      owner.store(std::this_thread::get_id(), std::memory_order_release);
       occupied_slots = 0;
-      free_slots_left = ((pages_mmaped * pagesize) - (2 * pagesize)) / sizeof(elem_type);
+      free_slots_left = ((pages_mmaped - (2 * guard_pgs)) * pagesize) / sizeof(elem_type);
       if (!commit_page(allocation_area)) {
         deinit_pool();
         return false;
       }
+      if constexpr (PoolCfg::use_prefault) {
+        // the whole capacity contract is paid here, once: commit, lock in RAM (best effort - RLIMIT_MEMLOCK
+        // may be lower than the pool) and write-touch every page, so the steady state takes neither a
+        // syscall nor a fault. first_not_commited at end_gp turns every later commit check into its early
+        // return, and grow_pool/decommit_tail refuse - overflow fails fast instead of stalling.
+        uint64_t base = reinterpret_cast<uint64_t>(allocation_area);
+        uint64_t len = reinterpret_cast<uint64_t>(end_gp) - base;
+        if (mprotect(reinterpret_cast<void *>(base), len, PROT_READ | PROT_WRITE) == -1) {
+          deinit_pool();
+          return false;
+        }
+        mlock(reinterpret_cast<void *>(base), len);
+        for (uint64_t pg = base; pg < base + len; pg += pagesize) *reinterpret_cast<volatile char *>(pg) = 0;
+        first_not_commited = end_gp;
+      }
       retValue = true;
     }
     return retValue;
   }
 
+  // On-disk header of a file-backed pool; lives in the first page of the file, before the leading guard page
+  struct file_header {
+    static constexpr std::uint64_t magic_value = 0x314c4f4f504b41ul;  // "AKPOOL1"
+    std::uint64_t magic;
+    std::uint64_t elem_size;
+    std::uint64_t pagesize;
+    std::uint64_t pages;           // total pages of the file (header + guards + usable area)
+    std::uint64_t occupied_slots;  // watermark at the last sync_file
+  };
+
+  file_header *fheader() { return reinterpret_cast<file_header *>(begin_gp); }
+
+  /**
+   * @brief The function maps a file instead of anonymous memory, so the pool's contents survive the process
+   *
+   * @param path    file to create or reopen;
+   * @param pgs     number of usable pages when creating (0 = allocate_pgs); ignored on reopen - the file knows its size;
+   * @return true   the pool runs on the file; on reopen occupied_slots is resumed from the header;
+   * @return false  can't open/size/map the file, or an existing file has a foreign/incompatible header.
+   *
+   * Layout: [header page][guard][usable area][guard] - guard pages bracket the usable area exactly like the anonymous
+   * pool, their file pages are simply never touched. Trivially-copyable records written before a sync_file can be
+   * remapped by a fresh process with zero deserialization. The mapping lands on a fresh base each run, so records must
+   * not contain pointers, and the free list (absolute pointers) is deliberately dropped on reopen - only the
+   * occupied_slots watermark resumes. The capacity is fixed by the file: grow_pool refuses to outgrow it.
+   */
+  bool init_file_pool(const char *path, std::size_t pgs = 0) {
+    Logger::log_line(__PRETTY_FUNCTION__, &pgs);
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd == -1) return false;
+    return map_backing_fd(fd, pgs);
+  }
+
+  /**
+   * @brief The function backs the pool with a named POSIX shared-memory segment, so several processes can map one
+   * allocation_area and hand containers of trivially-copyable records over without copy or serialization
+   *
+   * @param name    segment name for shm_open ("/something");
+   * @param pgs     number of usable pages when creating (0 = allocate_pgs); ignored when the segment already exists;
+   * @return true   the pool runs on the shared segment (header/layout exactly as init_file_pool);
+   * @return false  can't open/size/map the segment, or its header is foreign/incompatible.
+   *
+   * The pool's counters are per process: one producer creates the segment, allocates and publishes via sync_file
+   * (header watermark); consumers attach afterwards and read. Concurrent allocation from two processes is NOT
+   * coordinated. Each process maps the segment at its own base, so shared records must hold indices or offset_ptr
+   * (offset_ptr.h) instead of raw pointers.
+   */
+  bool init_shm_pool(const char *name, std::size_t pgs = 0) {
+    Logger::log_line(__PRETTY_FUNCTION__, &pgs);
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    if (fd == -1) return false;
+    return map_backing_fd(fd, pgs);
+  }
+
+  /**
+   * @brief The function maps the opened backing @fd (regular file or shm segment) and initializes/resumes the pool;
+   * the shared body of init_file_pool and init_shm_pool. Closes @fd on every failure path.
+   */
+  bool map_backing_fd(int fd, std::size_t pgs) {
+    if ((!pagesize && set_pagesize() == -1) || begin_gp != nullptr) {
+      close(fd);
+      return false;
+    }
+    if (!pgs) pgs = allocate_pgs;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+      close(fd);
+      return false;
+    }
+
+    std::size_t total_pgs = 1 + 2 * guard_pgs + pgs;
+    bool fresh = (st.st_size == 0);
+    if (fresh) {
+      if (ftruncate(fd, static_cast<off_t>(total_pgs * pagesize)) == -1) {
+        close(fd);
+        return false;
+      }
+    } else {
+      if (st.st_size % pagesize != 0 || static_cast<std::size_t>(st.st_size) < (1 + 2 * guard_pgs + 1) * static_cast<std::size_t>(pagesize)) {
+        close(fd);
+        return false;
+      }
+      total_pgs = static_cast<std::size_t>(st.st_size) / pagesize;
+    }
+
+    begin_gp = mmap(NULL, total_pgs * pagesize, PROT_NONE, MAP_SHARED, fd, 0);
+    if (begin_gp == MAP_FAILED) {
+      begin_gp = nullptr;
+      close(fd);
+      return false;
+    }
+    if constexpr (PoolCfg::numa_node >= 0) bind_to_node(begin_gp, total_pgs * pagesize);
+
+    // the header page is always committed; it sits outside [allocation_area, end_gp), so plain mprotect
+    if (mprotect(begin_gp, pagesize, PROT_READ | PROT_WRITE) == -1) {
+      munmap(begin_gp, total_pgs * pagesize);
+      begin_gp = nullptr;
+      close(fd);
+      return false;
+    }
+
+    pages_mmaped = total_pgs;
+    allocation_area = reinterpret_cast<elem_type *>(reinterpret_cast<uint64_t>(begin_gp) + ((1 + guard_pgs) * pagesize));
+    end_gp = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(begin_gp) + ((pages_mmaped - guard_pgs) * pagesize));
+    free_list = nullptr;
+    owner.store(std::this_thread::get_id(), std::memory_order_release);
+    free_slots_left = ((pages_mmaped - 1 - (2 * guard_pgs)) * pagesize) / sizeof(elem_type);
+
+    file_header *hdr = fheader();
+    if (fresh) {
+      *hdr = {file_header::magic_value, sizeof(elem_type), static_cast<std::uint64_t>(pagesize), total_pgs, 0};
+      occupied_slots = 0;
+    } else {
+      if (hdr->magic != file_header::magic_value || hdr->elem_size != sizeof(elem_type) || hdr->pagesize != static_cast<std::uint64_t>(pagesize) ||
+          hdr->pages != total_pgs || hdr->occupied_slots > free_slots_left) {
+        // the file is not ours: backing_fd is still unset, so this deinit can't sync_file a watermark into it -
+        // a refused attach must leave the file byte-identical
+        deinit_pool();
+        close(fd);
+        return false;
+      }
+      occupied_slots = hdr->occupied_slots;
+    }
+    // only now is the file known to be ours (or freshly stamped); from here deinit_pool may sync and close it
+    backing_fd = fd;
+    free_slots_left -= occupied_slots;
+
+    // commit up to the resumed watermark (at least the first usable page, matching init_pool)
+    uint64_t watermark = reinterpret_cast<uint64_t>(allocation_area + occupied_slots);
+    uint64_t committed_end = ((watermark + pagesize - 1) / pagesize) * pagesize;
+    uint64_t min_commit = reinterpret_cast<uint64_t>(allocation_area) + pagesize;
+    if (committed_end < min_commit) committed_end = min_commit;
+    first_not_commited = reinterpret_cast<void *>(committed_end);
+    if (mprotect(allocation_area, committed_end - reinterpret_cast<uint64_t>(allocation_area), PROT_READ | PROT_WRITE) == -1) {
+      deinit_pool();
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief The function snapshots a file-backed pool: the header gets the current watermark and the whole mapping is
+   * flushed to the file with msync, so a crash (or a fresh process) finds a consistent image
+   *
+   * @return true   the image is durable on disk;
+   * @return false  the pool is not file-backed, or msync failed.
+   */
+  bool sync_file() {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    if (backing_fd < 0 || begin_gp == nullptr) return false;
+    fheader()->occupied_slots = occupied_slots;
+    return msync(begin_gp, pages_mmaped * pagesize, MS_SYNC) == 0;
+  }
+
   /**
    * @brief This function requests deletes the mapping and de-initializes all the members
    *
@@ -231,11 +874,29 @@ struct mem_pool {
     Logger::log_line(__PRETTY_FUNCTION__);
     bool retValue = false;
     // already deinited
-    if (begin_gp == nullptr) return false;
+    if (begin_gp == nullptr && retired == nullptr) return false;
+    // stop the commit-ahead worker before any of the mappings go away
+    if constexpr (PoolCfg::use_async_commit) async_reset();
+
+    while (retired != nullptr) {
+      segment *seg = retired;
+      retired = seg->next;
+      munmap(seg->begin_gp, seg->pages_mmaped * pagesize);
+      delete seg;
+    }
+    if (begin_gp == nullptr) return true;
 
+    if (backing_fd >= 0) sync_file();
     if (munmap(begin_gp, pages_mmaped * pagesize) != -1) {
+      if (backing_fd >= 0) {
+        close(backing_fd);
+        backing_fd = -1;
+      }
       allocation_area = nullptr;
       begin_gp = end_gp = first_not_commited = nullptr;
+      free_list = nullptr;
+      owner.store(std::thread::id{}, std::memory_order_release);
+      remote_free.store(nullptr, std::memory_order_relaxed);
       pages_mmaped = occupied_slots = free_slots_left = 0;
       retValue = true;
     }
@@ -252,22 +913,112 @@ struct mem_pool {
    */
   void *get_allocation(std::size_t nmbr) {
     Logger::log_line(__PRETTY_FUNCTION__, &nmbr);
+    typename Locker::guard lock(pool_lock);
     void *retVal = nullptr;
+    drain_remote_frees();
+    if constexpr (inline_slots != 0)
+      if (retVal = inline_get(nmbr); retVal != nullptr) return retVal;
     if (begin_gp == nullptr && !init_pool(0)) return nullptr;
-    if (free_slots_left < nmbr) return nullptr;
+    if (free_slots_left < nmbr && !grow_pool(nmbr)) return nullptr;
+
+    // first try to reuse a freed interior run; its pages are already commited, so no commit check is needed here
+    if (retVal = reuse_freed_run(nmbr); retVal != nullptr) {
+      free_slots_left -= nmbr;
+      Logger::on_allocate(nmbr);
+      return retVal;
+    }
 
     // calculate the address of the last byte of the last allocated slot
     void *end_byte = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(allocation_area + occupied_slots + nmbr) - 1);
-    if (!checked_range_commit(end_byte))
-      retVal = nullptr;
-    else {
-      retVal = allocation_area + occupied_slots;
-      occupied_slots += nmbr;
-      free_slots_left -= nmbr;
+    if (!checked_range_commit(end_byte)) {
+      // free_slots_left can be made up of interior holes none of which fits @nmbr while the bump tail is too
+      // short - a capacity miss just like the free_slots_left gate above, so grow and retry the bump once
+      if (!grow_pool(nmbr)) return nullptr;
+      end_byte = reinterpret_cast<void *>(reinterpret_cast<uint64_t>(allocation_area + occupied_slots + nmbr) - 1);
+      if (!checked_range_commit(end_byte)) return nullptr;
     }
+    retVal = allocation_area + occupied_slots;
+    occupied_slots += nmbr;
+    free_slots_left -= nmbr;
+    Logger::on_allocate(nmbr);
+    Logger::on_occupied(occupied_slots);
     return retVal;
   }
 
+  /**
+   * @brief The function searches the free list (first fit) for a run of at least @nmbr contiguous free slots
+   *
+   * @param nmbr  the number of slots needed;
+   * @return  pointer to the first slot of the run carved from the free list;
+   *          nullptr when no run of the list can serve @nmbr slots.
+   *
+   * A run is carved from its front and the remainder stays on the free list. A run is only used when it fits exactly or
+   * when the remainder can still hold a free_node (big and aligned enough) — otherwise the leftover slots would become
+   * untracked.
+   */
+  void *reuse_freed_run(std::size_t nmbr) {
+    for (free_node **link = &free_list; *link != nullptr; link = &(*link)->next) {
+      free_node *node = *link;
+      if (node->slots < nmbr) continue;
+
+      std::size_t remainder = node->slots - nmbr;
+      if (remainder == 0)
+        *link = node->next;
+      else if (remainder * sizeof(elem_type) >= sizeof(free_node) && node_aligned(reinterpret_cast<elem_type *>(node) + nmbr)) {
+        free_node *rest = reinterpret_cast<free_node *>(reinterpret_cast<elem_type *>(node) + nmbr);
+        rest->next = node->next;
+        rest->slots = remainder;
+        *link = rest;
+      } else
+        continue;
+      return node;
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief The function retires the exhausted active mapping onto the chain and switches to a fresh mapping big enough
+   * for @nmbr slots (at least double the current size, like vector capacity growth)
+   *
+   * @param nmbr    the number of slots the failed allocation needs;
+   * @return true   the pool now runs on a bigger mapping and the allocation can be retried;
+   * @return false  can't mmap a bigger segment.
+   *
+   * Live allocations stay valid inside the retired segment; the segment is munmaped as soon as its last allocation is
+   * deleted (or at deinit_pool). Free-list runs of the old mapping are not carried over - they die with their segment.
+   */
+  bool grow_pool(std::size_t nmbr) {
+    Logger::log_line(__PRETTY_FUNCTION__, &nmbr);
+    if (begin_gp == nullptr) return false;
+    // a file-backed pool's capacity is the file picked at init_file_pool time; it never grows behind the file's back
+    if (backing_fd >= 0) return false;
+    // a real-time pool's capacity is its contract; a surprise mmap is exactly what the mode exists to rule out
+    if constexpr (PoolCfg::use_prefault) return false;
+
+    std::size_t needed_pgs = ((nmbr * sizeof(elem_type)) + pagesize - 1) / pagesize + 2;
+    std::size_t new_pgs = pages_mmaped * 2;
+    if (new_pgs < needed_pgs) new_pgs = needed_pgs;
+
+    std::size_t listed = 0;
+    for (free_node *node = free_list; node != nullptr; node = node->next) listed += node->slots;
+    std::size_t live = occupied_slots - listed;
+
+    // the task may still aim at the mapping that is about to be retired (or unmapped)
+    if constexpr (PoolCfg::use_async_commit) async_reset();
+
+    if (live == 0)
+      munmap(begin_gp, pages_mmaped * pagesize);
+    else
+      retired = new segment{retired, begin_gp, end_gp, allocation_area, pages_mmaped, live};
+
+    allocation_area = nullptr;
+    begin_gp = end_gp = first_not_commited = nullptr;
+    free_list = nullptr;
+    pages_mmaped = occupied_slots = free_slots_left = 0;
+
+    return init_pool(new_pgs);
+  }
+
   /**
    * @brief This function extends the already allocated area from @old_nmbr number of elements to @new_nmbr number of elements.
    *
@@ -281,8 +1032,21 @@ struct mem_pool {
   bool extend_allocation(void *ptr, std::size_t old_nmbr, std::size_t new_nmbr) {
     std::size_t allocate_nmbr = new_nmbr - old_nmbr;
     Logger::log_line(__PRETTY_FUNCTION__, &allocate_nmbr);
+    typename Locker::guard lock(pool_lock);
     bool retVal = false;
     if (!ptr) return false;
+    if constexpr (inline_slots != 0)
+      if (inline_owns(ptr)) {
+        // the run can grow in place when the following mask bits are free and still inside the buffer
+        std::size_t pos = static_cast<std::size_t>(reinterpret_cast<elem_type *>(ptr) - inline_begin());
+        std::uint64_t extra = inline_mask(allocate_nmbr) << (pos + old_nmbr);
+        if (pos + new_nmbr <= inline_slots && (inline_used & extra) == 0) {
+          inline_used |= extra;
+          retVal = true;
+        }
+        Logger::on_extend(retVal);
+        return retVal;
+      }
     if (begin_gp == nullptr) return false;
 
     if (free_slots_left < allocate_nmbr) return false;
@@ -298,12 +1062,63 @@ struct mem_pool {
       else {
         occupied_slots += allocate_nmbr;
         free_slots_left -= allocate_nmbr;
+        Logger::on_occupied(occupied_slots);
         retVal = true;
       }
     }
+    Logger::on_extend(retVal);
     return retVal;
   }
 
+  /**
+   * @brief This function shrinks the already allocated area from @old_nmbr number of elements to @new_nmbr number of elements, the symmetric counterpart of
+   * extend_allocation.
+   *
+   * @param ptr       the pointer to the first byte of the allocated area;
+   * @param old_nmbr  the current number of elements (occupied slots) in the allocated area;
+   * @param new_nmbr  the wanted number of elements (occupied slots) in the allocated area;
+   * @return true     the area now holds @new_nmbr elements and the tail slots are free again;
+   * @return false    the tail can't be returned (bad arguments, or an interior tail too small to hold a free_node).
+   *
+   * For the trailing allocation the bump pointer is simply rewound; for an interior allocation the tail run goes onto
+   * the free list. Either way this is a constant-time metadata update - no copy, no syscall.
+   */
+  bool shrink_allocation(void *ptr, std::size_t old_nmbr, std::size_t new_nmbr) {
+    std::size_t release_nmbr = old_nmbr - new_nmbr;
+    Logger::log_line(__PRETTY_FUNCTION__, &release_nmbr);
+    typename Locker::guard lock(pool_lock);
+    if (!ptr) return false;
+    if (new_nmbr > old_nmbr) return false;
+    if (new_nmbr == old_nmbr) return true;
+    if constexpr (inline_slots != 0)
+      if (inline_owns(ptr)) {
+        std::size_t pos = static_cast<std::size_t>(reinterpret_cast<elem_type *>(ptr) - inline_begin());
+        inline_used &= ~(inline_mask(release_nmbr) << (pos + new_nmbr));
+        return true;
+      }
+    elem_type *slot = reinterpret_cast<elem_type *>(ptr);
+    if (begin_gp == nullptr || slot < allocation_area || slot + old_nmbr > allocation_area + occupied_slots) {
+      // the block lives in a retired segment: its tail can't rejoin the active free list (a node there would
+      // hand out retired memory and skew that segment's live count), but the tail slots are no longer live
+      return delete_retired(slot + new_nmbr, release_nmbr);
+    }
+    if (slot + old_nmbr == allocation_area + occupied_slots) {
+      occupied_slots -= release_nmbr;
+      free_slots_left += release_nmbr;
+      rewind_over_free_list();
+      return true;
+    }
+    if (release_nmbr * sizeof(elem_type) >= sizeof(free_node) && node_aligned(slot + new_nmbr)) {
+      free_node *node = reinterpret_cast<free_node *>(slot + new_nmbr);
+      node->next = free_list;
+      node->slots = release_nmbr;
+      free_list = node;
+      free_slots_left += release_nmbr;
+      return true;
+    }
+    return false;
+  }
+
   /**
    * @brief The function deletes the previously done by get_allocation allocation call
    *
@@ -311,31 +1126,181 @@ struct mem_pool {
    * @param nmbr    the number of elements that has been asked from get_allocation;
    * @return true   the allocated elements have been succesfully deleted;
    * @return false  can't delete elements of this allocation (ptr or nmbr or both are not correct).
+   *
+   * The trailing allocation is returned by rewinding occupied_slots (and the rewind swallows free-list runs that end up
+   * adjacent to the new watermark). An interior allocation is threaded onto the free list in-place, so get_allocation can
+   * reuse the hole. Interior runs too small (or too misaligned) to hold a free_node stay unreachable until deinit_pool.
    */
   bool delete_allocation(void *ptr, std::size_t nmbr) {
     Logger::log_line(__PRETTY_FUNCTION__, &nmbr);
-    bool retVal = true;
     if (!ptr) return false;
-    if (begin_gp == nullptr) return false;
+    std::thread::id pool_owner = owner.load(std::memory_order_acquire);
+    if (pool_owner != std::thread::id{} && std::this_thread::get_id() != pool_owner) return remote_delete(ptr, nmbr);
+    typename Locker::guard lock(pool_lock);
+    return local_delete(ptr, nmbr);
+  }
+
+  /**
+   * @brief The function queues a deallocation arriving from a thread that does not own the pool
+   *
+   * @param ptr     the pointer that has been returned by get_allocation;
+   * @param nmbr    the number of elements that has been asked from get_allocation;
+   * @return true   the slots have been queued and will be reclaimed by the owner in get_allocation;
+   * @return false  the block is too small to carry a queue node (such foreign frees can't be tracked).
+   *
+   * Lock-free push onto the remote_free stack; the node lives inside the freed slots, like the free list.
+   */
+  bool remote_delete(void *ptr, std::size_t nmbr) {
+    if (nmbr * sizeof(elem_type) < sizeof(free_node) || !node_aligned(ptr)) return false;
+    free_node *node = reinterpret_cast<free_node *>(ptr);
+    node->slots = nmbr;
+    node->next = remote_free.load(std::memory_order_relaxed);
+    while (!remote_free.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return true;
+  }
+
+  /**
+   * @brief The function takes the whole remote-free stack in one exchange and reclaims every queued block. Must run on
+   * the owning thread with the pool guard held (get_allocation does).
+   */
+  void drain_remote_frees() {
+    free_node *pending = remote_free.exchange(nullptr, std::memory_order_acquire);
+    while (pending != nullptr) {
+      free_node *next = pending->next;
+      local_delete(pending, pending->slots);
+      pending = next;
+    }
+  }
 
-    // TODO: PARTIALLY IMPLEMENTED
+  // Writes the configured poison pattern over a freed run, so use-after-free reads surface as the pattern
+  static void poison_slots(void *ptr, std::size_t nmbr) {
+    if constexpr (PoolCfg::poison_byte >= 0)
+      std::memset(ptr, PoolCfg::poison_byte, nmbr * sizeof(elem_type));
+    else {
+      (void)ptr;
+      (void)nmbr;
+    }
+  }
 
-    occupied_slots -= nmbr;
-    free_slots_left += nmbr;
+  // owner-thread deallocation body shared by delete_allocation and drain_remote_frees: poisons and quarantines
+  // (when configured), then hands the run - or the one evicted from the quarantine - to finish_delete
+  bool local_delete(void *ptr, std::size_t nmbr) {
+    if constexpr (inline_slots != 0)
+      if (inline_owns(ptr)) {
+        poison_slots(ptr, nmbr);
+        return inline_delete(ptr, nmbr);
+      }
+    if (begin_gp == nullptr) return delete_retired(ptr, nmbr);
+
+    elem_type *check = reinterpret_cast<elem_type *>(ptr);
+    if (check < allocation_area || check + nmbr > allocation_area + occupied_slots) return delete_retired(ptr, nmbr);
+    if constexpr (PoolCfg::use_fence_pages) {
+      // a fenced run ends with its PROT_NONE trap page - poison only the data pages in front of it
+      std::size_t trap_slots = static_cast<std::size_t>(pagesize) / sizeof(elem_type);
+      if (nmbr > trap_slots) poison_slots(ptr, nmbr - trap_slots);
+    } else
+      poison_slots(ptr, nmbr);
+
+    if constexpr (quarantine_depth != 0) {
+      quarantined_run evicted{nullptr, 0};
+      if (quarantine_count == quarantine_depth)
+        evicted = quarantine.runs[quarantine_next];
+      else
+        ++quarantine_count;
+      quarantine.runs[quarantine_next] = {ptr, nmbr};
+      quarantine_next = (quarantine_next + 1) % quarantine_depth;
+      if (evicted.ptr == nullptr) return true;
+      // the fence layout protected the run on free and its tail is still a PROT_NONE trap page; the evicted run
+      // re-enters general circulation (free list / bump area) where ANY of its slots may be carved or hold a
+      // free_node header - recommit all of it, trap page included
+      if constexpr (PoolCfg::use_fence_pages)
+        mprotect(evicted.ptr, evicted.slots * sizeof(elem_type), PROT_READ | PROT_WRITE);
+      ptr = evicted.ptr;
+      nmbr = evicted.slots;
+    }
+    return finish_delete(ptr, nmbr);
+  }
+
+  // the actual free: trailing runs rewind the watermark, interior ones join the free list
+  bool finish_delete(void *ptr, std::size_t nmbr) {
+    bool retVal = true;
+    elem_type *slot = reinterpret_cast<elem_type *>(ptr);
+    // a run evicted from the quarantine may belong to a mapping the pool has retired since the free was parked
+    if (begin_gp == nullptr || slot < allocation_area || slot + nmbr > allocation_area + occupied_slots) return delete_retired(ptr, nmbr);
+    if (slot + nmbr == allocation_area + occupied_slots) {
+      // trailing allocation: rewind the bump pointer
+      occupied_slots -= nmbr;
+      free_slots_left += nmbr;
+      Logger::on_deallocate(nmbr);
+      rewind_over_free_list();
+    } else if (nmbr * sizeof(elem_type) >= sizeof(free_node) && node_aligned(slot)) {
+      // interior allocation: keep the hole on the free list for reuse
+      free_node *node = reinterpret_cast<free_node *>(slot);
+      node->next = free_list;
+      node->slots = nmbr;
+      free_list = node;
+      free_slots_left += nmbr;
+      Logger::on_deallocate(nmbr);
+    }
 
     return retVal;
   }
 
+  /**
+   * @brief The function deletes an allocation that lives in a retired segment of the chain
+   *
+   * @param ptr     the pointer that has been returned by get_allocation before the pool grew;
+   * @param nmbr    the number of elements that has been asked from get_allocation;
+   * @return true   the slots have been accounted to their segment (and the segment unmapped when it drained);
+   * @return false  no retired segment owns the pointer.
+   */
+  bool delete_retired(void *ptr, std::size_t nmbr) {
+    segment **link = find_retired(ptr);
+    if (link == nullptr) return false;
+
+    segment *seg = *link;
+    seg->live_slots = (seg->live_slots > nmbr) ? seg->live_slots - nmbr : 0;
+    if (seg->live_slots == 0) {
+      *link = seg->next;
+      munmap(seg->begin_gp, seg->pages_mmaped * pagesize);
+      delete seg;
+    }
+    return true;
+  }
+
+  /**
+   * @brief The function repeatedly pulls free-list runs that end exactly at the occupied_slots watermark back into the
+   * bump area, so the space freed in interior-then-trailing order does not stay fragmented on the list forever.
+   */
+  void rewind_over_free_list() {
+    bool rewound = true;
+    while (rewound) {
+      rewound = false;
+      for (free_node **link = &free_list; *link != nullptr; link = &(*link)->next) {
+        free_node *node = *link;
+        if (reinterpret_cast<elem_type *>(node) + node->slots == allocation_area + occupied_slots) {
+          *link = node->next;
+          occupied_slots -= node->slots;
+          rewound = true;
+          break;
+        }
+      }
+    }
+  }
+
   void swap(mem_pool &other) noexcept {
     Logger::log_line(__PRETTY_FUNCTION__);
-    mem_pool tmp(other);
+    // must be move-based: the copy Ctor maps a fresh pool instead of taking over the mapping,
+    // which would leave the other side's allocations dangling
+    mem_pool tmp(std::move(other));
     other = std::move(*this);
     *this = std::move(tmp);
   }
 };
 
-template <typename _Tp, typename Logger>
-void swap(mem_pool<_Tp, Logger> &lhs, mem_pool<_Tp, Logger> &rhs) {
+template <typename _Tp, typename Logger, typename Locker, typename PoolCfg>
+void swap(mem_pool<_Tp, Logger, Locker, PoolCfg> &lhs, mem_pool<_Tp, Logger, Locker, PoolCfg> &rhs) {
   Logger::log_line(__PRETTY_FUNCTION__);
   lhs.swap(rhs);
 }
@@ -349,7 +1314,7 @@ void swap(mem_pool<_Tp, Logger> &lhs, mem_pool<_Tp, Logger> &rhs) {
 
 }  // namespace __detail
 
-template <typename _Tp, std::size_t _MaxObjects = 10, typename Logger = non_log>
+template <typename _Tp, std::size_t _MaxObjects = 10, typename Logger = non_log, typename Locker = no_lock, typename PoolCfg = pool_defaults>
 class page_allocator {
  public:
   using value_type = _Tp;
@@ -366,18 +1331,19 @@ class page_allocator {
 
   template <typename _Tp1>
   struct rebind {
-    using other = page_allocator<_Tp1, _MaxObjects, Logger>;
+    using other = page_allocator<_Tp1, _MaxObjects, Logger, Locker, PoolCfg>;
   };
 
   constexpr page_allocator() noexcept : _pool() { Logger::log_line(__PRETTY_FUNCTION__); }
 
   constexpr page_allocator(const page_allocator &other) noexcept : _pool(other.get_mem_pool()) { Logger::log_line(__PRETTY_FUNCTION__); }
 
-  constexpr page_allocator(page_allocator &&rhs) noexcept : _pool(std::move(rhs.get_mem_pool())) { Logger::log_line(__PRETTY_FUNCTION__); }
+  // NOTE: must move _pool directly - get_mem_pool() returns a const ref, and std::move of it would silently pick the copy Ctor (fresh mapping)
+  constexpr page_allocator(page_allocator &&rhs) noexcept : _pool(std::move(rhs._pool)) { Logger::log_line(__PRETTY_FUNCTION__); }
 
   // Conversion copy Ctor
   template <typename _Tp1, std::size_t _MaxObjects1>
-  constexpr page_allocator(const page_allocator<_Tp1, _MaxObjects1, Logger> &other) noexcept : _pool(other.get_mem_pool()) {
+  constexpr page_allocator(const page_allocator<_Tp1, _MaxObjects1, Logger, Locker, PoolCfg> &other) noexcept : _pool(other.get_mem_pool()) {
     Logger::log_line(__PRETTY_FUNCTION__);
   }
 
@@ -389,13 +1355,13 @@ class page_allocator {
 
   page_allocator &operator=(page_allocator &&rhs) {
     Logger::log_line(__PRETTY_FUNCTION__);
-    _pool = std::move(rhs.get_mem_pool());
+    _pool = std::move(rhs._pool);
     return *this;
   }
 
   ~page_allocator() {
     Logger::log_line(__PRETTY_FUNCTION__);
-    if (_pool.begin_gp != nullptr && !_pool.deinit_pool()) std::__throw_runtime_error("page_allocator: Can't deallocate ...");
+    if ((_pool.begin_gp != nullptr || _pool.retired != nullptr) && !_pool.deinit_pool()) std::__throw_runtime_error("page_allocator: Can't deallocate ...");
   }
 
   /**
@@ -417,8 +1383,15 @@ class page_allocator {
     if (__n > this->_M_max_size()) std::__throw_bad_alloc();
     // fix for std::map: allow _MaxObjects max allocations and then shoot 'em
     // occupied_slots start counting from 0, so +1
-    if (_pool.occupied_slots + 1 > this->max_size()) std::__throw_bad_alloc();
-
+    if (_pool.occupied() + 1 > this->max_size()) std::__throw_bad_alloc();
+
+    if constexpr (PoolCfg::use_fence_pages) return fence_allocate(__n);
+    if constexpr (PoolCfg::use_prefault) {
+      // overflow of the capacity contract fails fast; the registered handler (if any) gets to report it
+      _Tp *__p = static_cast<_Tp *>(_pool.get_allocation(__n));
+      if (__p == nullptr && _S_overflow_handler != nullptr) _S_overflow_handler(__n);
+      return __p;
+    }
     return static_cast<_Tp *>(_pool.get_allocation(__n));
   }
 
@@ -431,9 +1404,46 @@ class page_allocator {
    */
   void deallocate(_Tp *__p, size_type __t) {
     Logger::log_line(__PRETTY_FUNCTION__, &__t);
+    if constexpr (PoolCfg::use_fence_pages) return fence_deallocate(__p, __t);
     _pool.delete_allocation(__p, __t);
   }
 
+  /**
+   *  @brief  Allocates @__count contiguous blocks of @__n_each objects in ONE pool transaction
+   *  @param  __count   the number of blocks;
+   *  @param  __n_each  the number of objects per block;
+   *  @return Pointer to the first block; block i starts at the returned pointer + i * __n_each.
+   *          nullptr when the batch can't be served.
+   *
+   *  The pool's bump layout makes a batch a single carve: one lock acquisition, one commit-range check and one
+   *  log record cover all @__count blocks, instead of per-block calls through allocate(). The blocks are
+   *  contiguous, so sibling nodes built from one batch pack cache lines. Free either per block
+   *  (deallocate(block_i, __n_each) - trailing blocks rewind, interior ones go to the free list) or wholesale
+   *  with deallocate_batch. The _MaxObjects throttle deliberately does not apply: batching exists for bulk
+   *  loads the throttle would only fight.
+   */
+  [[__nodiscard__]] _Tp *allocate_batch(size_type __count, size_type __n_each) {
+    size_type __total = __count * __n_each;
+    Logger::log_line(__PRETTY_FUNCTION__, &__total);
+    if (__count != 0 && __total / __count != __n_each) return nullptr;  // multiplication overflow
+    if (__total > this->_M_max_size()) return nullptr;
+    return static_cast<_Tp *>(_pool.get_allocation(__total));
+  }
+
+  /**
+   *  @brief  Returns a whole batch obtained from allocate_batch in one pool transaction
+   *  @param  __p       the pointer allocate_batch returned;
+   *  @param  __count   the block count passed to allocate_batch;
+   *  @param  __n_each  the per-block object count passed to allocate_batch.
+   *
+   *  Only valid when every block of the batch is dead; blocks freed individually must not be returned again.
+   */
+  void deallocate_batch(_Tp *__p, size_type __count, size_type __n_each) {
+    size_type __total = __count * __n_each;
+    Logger::log_line(__PRETTY_FUNCTION__, &__total);
+    _pool.delete_allocation(__p, __total);
+  }
+
   /**
    *  @brief  Returns the largest supported allocation size
    *
@@ -448,23 +1458,172 @@ class page_allocator {
 
   // proxy function
   bool extend_allocation(_Tp *__p, std::size_t __sz, std::size_t __new_sz) {
+    // the fence layout pins an allocation between its page start and its trap page - nothing can extend in place
+    if constexpr (PoolCfg::use_fence_pages) return false;
     Logger::log_line(__PRETTY_FUNCTION__, &__new_sz);
     return _pool.extend_allocation(__p, __sz, __new_sz);
   }
 
+  // proxy function
+  bool shrink_allocation(_Tp *__p, std::size_t __sz, std::size_t __new_sz) {
+    if constexpr (PoolCfg::use_fence_pages) return false;
+    Logger::log_line(__PRETTY_FUNCTION__, &__new_sz);
+    return _pool.shrink_allocation(__p, __sz, __new_sz);
+  }
+
+  /**
+   *  @brief  Checks whether @__p was carved out of this allocator's pool
+   *
+   *  Two pointer compares on the hot path (plus a walk of the retired-segment chain on a miss), so a composite
+   *  allocator can route a deallocation among several pools in O(1) without a lookup table.
+   */
+  bool owns(const void *__p) const noexcept {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    return const_cast<__detail::mem_pool<_Tp, Logger, Locker, PoolCfg> &>(_pool).owns(const_cast<void *>(__p));
+  }
+
+  /**
+   *  @brief  Returns the committed-but-unused tail of the pool to the OS
+   *
+   *  A non-binding request (like shrink_to_fit): the mapping and all live allocations stay valid, only pages past the
+   *  allocation watermark are decommited via MADV_FREE.
+   */
+  bool shrink() {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    return _pool.decommit_tail();
+  }
+
+  /**
+   *  @brief  Maps the pool now instead of on the first allocation
+   *
+   *  The constructors stay lazy (and constexpr); a latency-bound thread calls warm() once at startup so the
+   *  mmap - and in prefault mode (realtime_pool) the full commit, mlock and pre-touch of the capacity
+   *  contract - happens before the hot path starts. Idempotent on an already-mapped pool.
+   */
+  bool warm() {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    return _pool.begin_gp != nullptr || _pool.init_pool(0);
+  }
+
+  /**
+   *  @brief  Registers a callback invoked (with the failed request size) when a prefault pool's capacity
+   *  contract is exhausted
+   *
+   *  allocate still returns nullptr afterwards - the handler exists for reporting, not for recovery. Shared by
+   *  every pool of this instantiation, like the Logger's counters.
+   */
+  static void set_overflow_handler(void (*__fn)(size_type)) noexcept { _S_overflow_handler = __fn; }
+
+  /**
+   *  @brief  Invalidates every outstanding allocation at once and rewinds the pool to empty (arena teardown)
+   *
+   *  O(1) end-of-request teardown: no per-block delete_allocation walk, and the mapping stays for the next
+   *  epoch. All pointers handed out before the reset are invalid afterwards - the caller owns that contract.
+   *  @__release_pages additionally returns the committed pages to the OS. Each reset bumps epoch().
+   */
+  bool reset(bool __release_pages = false) {
+    Logger::log_line(__PRETTY_FUNCTION__);
+    return _pool.reset(__release_pages);
+  }
+
+  /// Generation counter of the pool, bumped by every reset(); stamp handles with it to catch stale use in debug builds
+  size_type epoch() const noexcept { return _pool.pool_epoch; }
+
+  /**
+   *  @brief  Backs the pool with @__path instead of anonymous memory (file-backed mode)
+   *
+   *  Must run before the first allocation. A fresh file is sized for @__pgs usable pages; an existing file is
+   *  validated against its header and the allocation watermark resumes, so a vector of trivially-copyable records
+   *  written by a previous process is readable with zero deserialization. See mem_pool::init_file_pool for the
+   *  layout and the no-pointers caveat.
+   */
+  bool attach_file(const char *__path, std::size_t __pgs = 0) { return _pool.init_file_pool(__path, __pgs); }
+
+  /**
+   *  @brief  Flushes a file-backed pool to disk (header watermark + msync), making the on-disk image consistent
+   */
+  bool snapshot() { return _pool.sync_file(); }
+
+  /**
+   *  @brief  Backs the pool with the named POSIX shared-memory segment @__name, shared between processes
+   *
+   *  Same header/layout/resume rules as attach_file; the producer publishes with snapshot(), consumers attach and
+   *  read. Shared records must hold indices or offset_ptr (offset_ptr.h), never raw pointers - each process maps
+   *  the segment at its own base.
+   */
+  bool attach_shm(const char *__name, std::size_t __pgs = 0) { return _pool.init_shm_pool(__name, __pgs); }
+
+  /// Removes the named shared-memory segment (it disappears once the last attached process detaches)
+  static bool unlink_shm(const char *__name) noexcept { return shm_unlink(__name) == 0; }
+
   void swap(page_allocator &other) noexcept {
     Logger::log_line(__PRETTY_FUNCTION__);
-    page_allocator tmp(other);
+    page_allocator tmp(std::move(other));
     other = std::move(*this);
     *this = std::move(tmp);
   }
 
-  const __detail::mem_pool<_Tp, Logger> &get_mem_pool() const noexcept {
+  /**
+   *  @brief  Aggregate counters kept by the Logger policy
+   *
+   *  Only well-formed for counting policies (stats_log); allocations, bytes committed, in-place extend hit rate and
+   *  peak occupancy are the inputs for sizing _MaxObjects and the pool page count.
+   */
+  static const alloc_stats &stats() noexcept { return Logger::stats(); }
+
+  const __detail::mem_pool<_Tp, Logger, Locker, PoolCfg> &get_mem_pool() const noexcept {
     Logger::log_line(__PRETTY_FUNCTION__);
     return _pool;
   }
 
  private:
+  using elem_type = typename __detail::mem_pool<_Tp, Logger, Locker, PoolCfg>::elem_type;
+
+  /**
+   *  @brief  Electric-fence allocation: @__n objects end-aligned on their own page(s), followed by a PROT_NONE
+   *  trap page inside the mapping
+   *
+   *  The run is padded to whole pages plus one trap page and carved from the pool as one allocation; the object
+   *  is placed so its last byte abuts the trap page, so the first out-of-bounds write faults immediately. The
+   *  data pages are recommitted explicitly (the run may recycle a previous trap page). Elements whose size does
+   *  not divide the page size can't keep slot alignment under this layout and are served unfenced.
+   */
+  _Tp *fence_allocate(size_type __n) {
+    if (_pool.pagesize == 0 && _pool.set_pagesize() == -1) return nullptr;
+    const size_type __ps = static_cast<size_type>(_pool.pagesize);
+    const size_type __spp = __ps / sizeof(elem_type);
+    if (__spp == 0 || __ps % sizeof(elem_type) != 0) return static_cast<_Tp *>(_pool.get_allocation(__n));
+
+    const size_type __data_slots = ((__n + __spp - 1) / __spp) * __spp;
+    elem_type *__raw = static_cast<elem_type *>(_pool.get_allocation(__data_slots + __spp));
+    if (__raw == nullptr) return nullptr;
+    mprotect(__raw, __data_slots * sizeof(elem_type), PROT_READ | PROT_WRITE);
+    mprotect(__raw + __data_slots, __ps, PROT_NONE);
+    return reinterpret_cast<_Tp *>(__raw + (__data_slots - __n));
+  }
+
+  /**
+   *  @brief  Frees a fenced allocation: the pool poisons and quarantines the padded run, then the data pages are
+   *  protected so any use-after-free faults until the run leaves the quarantine
+   *
+   *  Foreign-thread frees skip the protection - their runs sit in the remote queue with a live node inside.
+   */
+  void fence_deallocate(_Tp *__p, size_type __n) {
+    if (__p == nullptr) return;
+    const size_type __ps = static_cast<size_type>(_pool.pagesize);
+    const size_type __spp = __ps / sizeof(elem_type);
+    if (__spp == 0 || __ps % sizeof(elem_type) != 0) {
+      _pool.delete_allocation(__p, __n);
+      return;
+    }
+
+    const size_type __data_slots = ((__n + __spp - 1) / __spp) * __spp;
+    elem_type *__raw = reinterpret_cast<elem_type *>(__p) - (__data_slots - __n);
+    bool __local = (std::this_thread::get_id() == _pool.owner.load(std::memory_order_acquire));
+    _pool.delete_allocation(__raw, __data_slots + __spp);
+    if (__local) mprotect(__raw, __data_slots * sizeof(elem_type), PROT_NONE);
+  }
+
   constexpr size_type _M_max_size() const noexcept {
     Logger::log_line(__PRETTY_FUNCTION__);
     /**
@@ -477,17 +1636,20 @@ class page_allocator {
   // Maximum number of objects to allocate (infinity if 0)
   std::size_t objs_number{_MaxObjects};
 
-  __detail::mem_pool<_Tp, Logger> _pool;
+  // Overflow callback of the prefault mode (set_overflow_handler); nullptr = fail silently
+  static inline void (*_S_overflow_handler)(size_type) = nullptr;
+
+  __detail::mem_pool<_Tp, Logger, Locker, PoolCfg> _pool;
 };
 
-template <typename _Tp, std::size_t _MaxObjects, typename Logger>
-void swap(page_allocator<_Tp, _MaxObjects, Logger> &lhs, page_allocator<_Tp, _MaxObjects, Logger> &rhs) {
+template <typename _Tp, std::size_t _MaxObjects, typename Logger, typename Locker, typename PoolCfg>
+void swap(page_allocator<_Tp, _MaxObjects, Logger, Locker, PoolCfg> &lhs, page_allocator<_Tp, _MaxObjects, Logger, Locker, PoolCfg> &rhs) {
   Logger::log_line(__PRETTY_FUNCTION__);
   lhs.swap(rhs);
 }
 
-template <class _Tp1, class _Tp2, std::size_t _MaxObjects, typename Logger>
-bool operator==(const page_allocator<_Tp1, _MaxObjects, Logger> &, const page_allocator<_Tp2, _MaxObjects, Logger> &) noexcept {
+template <class _Tp1, class _Tp2, std::size_t _MaxObjects, typename Logger, typename Locker, typename PoolCfg>
+bool operator==(const page_allocator<_Tp1, _MaxObjects, Logger, Locker, PoolCfg> &, const page_allocator<_Tp2, _MaxObjects, Logger, Locker, PoolCfg> &) noexcept {
   Logger::log_line(__PRETTY_FUNCTION__);
 
   /*
@@ -507,8 +1669,8 @@ bool operator==(const page_allocator<_Tp1, _MaxObjects, Logger> &, const page_al
     return false;
 }
 
-template <class _Tp1, class _Tp2, std::size_t _MaxObjects, typename Logger>
-bool operator!=(const page_allocator<_Tp1, _MaxObjects, Logger> &__a, const page_allocator<_Tp2, _MaxObjects, Logger> &__b) noexcept {
+template <class _Tp1, class _Tp2, std::size_t _MaxObjects, typename Logger, typename Locker, typename PoolCfg>
+bool operator!=(const page_allocator<_Tp1, _MaxObjects, Logger, Locker, PoolCfg> &__a, const page_allocator<_Tp2, _MaxObjects, Logger, Locker, PoolCfg> &__b) noexcept {
   Logger::log_line(__PRETTY_FUNCTION__);
   return !(__a == __b);
 }
@@ -517,9 +1679,66 @@ bool operator!=(const page_allocator<_Tp1, _MaxObjects, Logger> &__a, const page
 template <typename _Tp, std::size_t _MaxObjects = 10>
 using p_alloc_log = ak_allocator::page_allocator<_Tp, _MaxObjects, cout_log>;
 
+// Traced pool whose log lines go to ak_alloc_trace.bin through the asynchronous ring-buffer writer
+template <typename _Tp, std::size_t _MaxObjects = 10>
+using p_alloc_file_log = ak_allocator::page_allocator<_Tp, _MaxObjects, file_log>;
+
+// Timestamped tracing pool: every mem_pool entry point is recorded with rdtsc and thread id into
+// ak_alloc_trace_tsc.bin; decode with the trace_decode tool into Chrome trace-event JSON
+template <typename _Tp, std::size_t _MaxObjects = 10>
+using p_alloc_trace = ak_allocator::page_allocator<_Tp, _MaxObjects, trace_log>;
+
 template <typename _Tp, std::size_t _MaxObjects = 10>
 using p_alloc = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log>;
 
+template <typename _Tp, std::size_t _MaxObjects = 10>
+using p_alloc_mt = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, spin_lock>;
+
+// Huge-page-backed pool for big, mostly-sequential containers (no allocation-count throttle)
+template <typename _Tp, std::size_t _MaxObjects = 0>
+using p_alloc_huge = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, huge_pool>;
+
+// Dense guard-free pool for trusted release builds
+template <typename _Tp, std::size_t _MaxObjects = 10>
+using p_alloc_noguard = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, no_guard_pool>;
+
+// Pool that commits its growth overshoot on a shared background thread (no allocation-count throttle):
+// bulk-ingest loops pay one small mprotect per growth step while the worker faults pages in ahead of them
+template <typename _Tp, std::size_t _MaxObjects = 0>
+using p_alloc_async = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, async_commit_pool>;
+
+// Hardened debug pool (fence pages + poison + quarantine): a self-contained ASan stand-in for chasing heap
+// corruption; pages-per-allocation overhead, so debug builds only
+template <typename _Tp, std::size_t _MaxObjects = 0>
+using p_alloc_debug = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, debug_pool>;
+
+// Pool whose first mapping spans a compile-time number of pages (no allocation-count throttle):
+// p_alloc_sized<_Tp, 3> for a tiny map (the minimum with guard pages), p_alloc_sized<_Tp, 16384> for a
+// 64 MB column buffer
+template <typename _Tp, std::size_t _Pages, std::size_t _MaxObjects = 0>
+using p_alloc_sized = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, sized_pool<_Pages>>;
+
+// Pool whose pages all live on one NUMA node (no allocation-count throttle): bind the data to the socket
+// that scans it instead of to whichever CPU happened to fault it in first
+template <typename _Tp, int _Node, std::size_t _MaxObjects = 0>
+using p_alloc_numa = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, numa_pool<_Node>>;
+
+// Small-container pool: the first _Slots element slots are embedded in the allocator object itself and the
+// mmap'd pool only appears when they overflow (no allocation-count throttle). Do not move or swap the
+// allocator while inline allocations are live.
+template <typename _Tp, std::size_t _Slots = 8>
+using p_alloc_small = ak_allocator::page_allocator<_Tp, 0, non_log, no_lock, inline_pool<_Slots>>;
+
+// Bounded-latency pool for real-time threads: warm() once at startup pays for the whole _Pages capacity
+// contract (commit + mlock + pre-touch), then allocation and in-place extend are syscall- and fault-free and
+// overflow fails fast (no allocation-count throttle). Pair with vector::reserve for a zero-syscall steady state.
+template <typename _Tp, std::size_t _Pages, std::size_t _MaxObjects = 0>
+using p_alloc_rt = ak_allocator::page_allocator<_Tp, _MaxObjects, non_log, no_lock, realtime_pool<_Pages>>;
+
+// Silent pool that keeps aggregate counters, readable through page_allocator::stats()
+template <typename _Tp, std::size_t _MaxObjects = 10>
+using p_alloc_stats = ak_allocator::page_allocator<_Tp, _MaxObjects, stats_log>;
+
 }  // namespace ak_allocator
 
 #endif
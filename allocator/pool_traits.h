@@ -0,0 +1,115 @@
+#ifndef _POOL_TRAITS_H_
+#define _POOL_TRAITS_H_
+
+#include <cstddef>
+
+// Compile-time configuration of mem_pool's mapping layout, selected like the Logger/Locker policies.
+// Derive from pool_defaults and override the knobs you need.
+struct pool_defaults {
+  // Back the mapping with 2 MB huge pages (MAP_HUGETLB, falling back to MADV_HUGEPAGE when the hugetlb
+  // pool is not configured) and commit in huge-page-sized strides instead of 4 KB ones
+  static constexpr bool use_huge_pages = false;
+
+  // Stride used as the pool's page size in huge-page mode
+  static constexpr std::size_t huge_page_size = 2u << 20;
+
+  // Bracket the usable area with PROT_NONE guard pages that trap over/underflows. Costs two pages per
+  // pool; trusted release builds can turn it off for a denser layout.
+  static constexpr bool use_guard_pages = true;
+
+  // Number of element slots embedded directly inside mem_pool and served before any mmap'd memory
+  // (0 = no inline tier). Small containers then pay no syscall at all and get stack-like locality.
+  // The slots live inside the pool object itself, so a pool holding live inline allocations must not
+  // be moved or swapped - opt in per container, see inline_pool below.
+  static constexpr std::size_t inline_slots = 0;
+
+  // Number of pages the first mapping of the pool spans (the usable area plus guards). A compile-time
+  // constant, so the default-size slot math constant-folds and one template serves both a tiny 2-page pool
+  // for a small map and a multi-GB pool for column buffers. grow_pool still doubles from here at runtime.
+  static constexpr std::size_t pool_pages = 256;
+
+  // Hardened-debug knobs, see debug_pool below. poison_byte (-1 = off, else 0..255) fills freed slots so
+  // use-after-free reads surface as an obvious pattern; quarantine_depth (0 = off) holds that many recently
+  // freed runs back from reuse so stale pointers keep pointing at poisoned (or fenced-out) memory for a while;
+  // use_fence_pages gives every allocation its own page(s) followed by a PROT_NONE trap page and protects
+  // freed runs, so overflows and use-after-free fault immediately instead of corrupting a neighbour slot.
+  static constexpr bool use_fence_pages = false;
+  static constexpr int poison_byte = -1;
+  static constexpr std::size_t quarantine_depth = 0;
+
+  // Commit the mprotect overshoot on a shared background thread instead of synchronously: get_allocation /
+  // extend_allocation return right after committing the range the caller needs, and the committer walks the
+  // rest ahead of the write cursor (prefaulting where the kernel supports it). Purely an accelerator - if the
+  // writer overtakes the worker, the next commit check simply mprotects synchronously as before.
+  static constexpr bool use_async_commit = false;
+
+  // Real-time mode: init_pool commits, mlocks and touches the WHOLE usable area up front, and the pool never
+  // grows or decommits afterwards - allocate/extend are syscall-free until the capacity contract (pool_pages)
+  // is exhausted, then they fail fast (nullptr/false) instead of stalling on a surprise mmap/mprotect.
+  static constexpr bool use_prefault = false;
+
+  // NUMA node the mapping is bound to with mbind(MPOL_BIND) at init_pool time (-1 = no binding, pages land
+  // on whichever node first touches them). With a binding, commit_page faults allocate on the target node no
+  // matter which CPU runs them - the right choice when the thread that scans the data is pinned to a socket.
+  static constexpr int numa_node = -1;
+};
+
+// Huge-page backing for large sequential workloads (big analytical vectors): fewer mprotect calls
+// to commit the same range and less dTLB pressure on scans
+struct huge_pool : pool_defaults {
+  static constexpr bool use_huge_pages = true;
+};
+
+// Small-buffer tier for the little containers that dominate request handling (the 3-node map case):
+// the first _Slots element slots are carved from the pool object itself and the mmap'd pool only
+// appears when they overflow. Do not move/swap the allocator while inline allocations are live.
+template <std::size_t _Slots>
+struct inline_pool : pool_defaults {
+  static constexpr std::size_t inline_slots = _Slots;
+};
+
+// Overlapped page commit for bulk-ingest paths: the caller parses while the committer faults pages in ahead
+// of it, instead of stalling on serial mprotect before every multi-megabyte reserve
+struct async_commit_pool : pool_defaults {
+  static constexpr bool use_async_commit = true;
+};
+
+// Electric-fence-style hardened debug pool: a fast, self-contained alternative to ASan for reproducing
+// production-only heap corruption. Overhead is pages per allocation plus two mprotect calls, so keep it to
+// debug builds. In-place extend/shrink are disabled under the fence layout (containers fall back to
+// allocate-and-copy), and foreign-thread frees are reclaimed without the fence protection.
+struct debug_pool : pool_defaults {
+  static constexpr bool use_fence_pages = true;
+  static constexpr int poison_byte = 0xDE;
+  static constexpr std::size_t quarantine_depth = 16;
+};
+
+// Pool with a compile-time first-mapping size of _Pages pages: sized_pool<3> (one usable page between the
+// guards) for tiny maps, sized_pool<16384> (64 MB) for column buffers - same template, no runtime sizing state
+template <std::size_t _Pages>
+struct sized_pool : pool_defaults {
+  static constexpr std::size_t pool_pages = _Pages;
+};
+
+// Socket-pinned pool: every page of the mapping is placed on NUMA node _Node. Binding failures (kernel
+// without NUMA, invalid node) are ignored and the pool degrades to first-touch placement.
+template <int _Node>
+struct numa_pool : pool_defaults {
+  static constexpr int numa_node = _Node;
+};
+
+// Bounded-latency pool for real-time threads: the capacity contract is _Pages pages, fully committed, locked
+// in RAM and pre-touched by the first init (see page_allocator::warm), so the steady state provably performs
+// no syscalls and takes no page faults. Overflowing the contract fails fast - size _Pages for the worst case.
+template <std::size_t _Pages>
+struct realtime_pool : sized_pool<_Pages> {
+  static constexpr bool use_prefault = true;
+};
+
+// Dense, guard-free layout for trusted containers: the whole mapping is usable area and no mprotect
+// protection-domain crossings surround it. Debug builds should stay on pool_defaults.
+struct no_guard_pool : pool_defaults {
+  static constexpr bool use_guard_pages = false;
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef _SIZE_CLASS_ALLOCATOR_H_
+#define _SIZE_CLASS_ALLOCATOR_H_
+
+#include "page_allocator.h"
+
+namespace ak_allocator {
+
+namespace __detail {
+
+// Slot of one size class. _Bytes is a power of two, so slot i of the page-aligned run sits on a _Bytes
+// boundary and any element with sizeof(_Tp) <= _Bytes (which implies alignof(_Tp) <= _Bytes) fits one slot.
+template <std::size_t _Bytes>
+struct sc_slot {
+  alignas(_Bytes) unsigned char bytes[_Bytes];
+};
+
+// Smallest class of 8/16/32/64 bytes that holds one object of @bytes; bigger objects span several
+// 64-byte slots of the largest class
+constexpr std::size_t sc_class_of(std::size_t bytes) { return bytes <= 8 ? 8 : bytes <= 16 ? 16 : bytes <= 32 ? 32 : 64; }
+
+// One process-wide pool per (slot size, Locker): every sc_alloc instance whose element lands in the class
+// draws from the same mapping, however the instance was reached - direct use or std::map's rebind-per-node.
+// The pool outlives any single container by design; its mapping is torn down once, at process exit.
+template <std::size_t _Bytes, typename Locker>
+struct size_class_backend {
+  mem_pool<sc_slot<_Bytes>, non_log, Locker> pool;
+
+  ~size_class_backend() {
+    if (pool.begin_gp != nullptr || pool.retired != nullptr) pool.deinit_pool();
+  }
+
+  static size_class_backend &instance() {
+    static size_class_backend inst;
+    return inst;
+  }
+};
+
+}  // namespace __detail
+
+/**
+ * Size-class allocator: a shared backend behind the page_allocator machinery. page_allocator's rebind hands every
+ * rebound type its own future mapping, so a std::map<int,int> plus its node rebinds can reserve several pools for
+ * one tiny container. sc_alloc instead routes each value_type to one of four process-wide size-class pools
+ * (8/16/32/64-byte slots; larger types span several 64-byte slots), so thousands of live containers share four
+ * mappings instead of holding one each. operator== reflects the real ownership: two instances compare equal
+ * exactly when their element types land in the same class, i.e. when they draw from the same pool.
+ *
+ * The backend is guarded by @Locker (spin_lock by default - it is shared across containers, and possibly
+ * threads); single-threaded builds that want the lock gone can instantiate sc_alloc<_Tp, no_lock>.
+ */
+template <typename _Tp, typename Locker = spin_lock>
+class sc_alloc {
+ public:
+  using value_type = _Tp;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  // all instances over the same class are views of one backend, so same-type instances always compare equal
+  using is_always_equal = std::true_type;
+  using continuous_allocator = std::true_type;
+
+  // number of bytes of the size class serving _Tp
+  static constexpr std::size_t slot_bytes = __detail::sc_class_of(sizeof(_Tp));
+  static_assert(alignof(_Tp) <= slot_bytes, "sc_alloc: over-aligned types don't fit the size-class layout");
+
+  template <typename _Tp1>
+  struct rebind {
+    using other = sc_alloc<_Tp1, Locker>;
+  };
+
+  constexpr sc_alloc() noexcept = default;
+  constexpr sc_alloc(const sc_alloc &) noexcept = default;
+
+  // Conversion copy Ctor (the rebind-per-node pattern of std::map lands here); nothing to carry over - the
+  // state lives in the per-class backends
+  template <typename _Tp1>
+  constexpr sc_alloc(const sc_alloc<_Tp1, Locker> &) noexcept {}
+
+  [[__nodiscard__]] _Tp *allocate(size_type __n, const void * = static_cast<const void *>(0)) {
+    if (__n > _M_max_size()) std::__throw_bad_alloc();
+    return reinterpret_cast<_Tp *>(backend_type::instance().pool.get_allocation(_S_slots(__n)));
+  }
+
+  void deallocate(_Tp *__p, size_type __t) { backend_type::instance().pool.delete_allocation(__p, _S_slots(__t)); }
+
+  size_type max_size() const noexcept { return _M_max_size(); }
+
+  // proxy function; object counts are translated to whole slots, so a request that stays within the same slot
+  // count is already satisfied in place
+  bool extend_allocation(_Tp *__p, std::size_t __sz, std::size_t __new_sz) {
+    if (_S_slots(__new_sz) == _S_slots(__sz)) return true;
+    return backend_type::instance().pool.extend_allocation(__p, _S_slots(__sz), _S_slots(__new_sz));
+  }
+
+  // proxy function
+  bool shrink_allocation(_Tp *__p, std::size_t __sz, std::size_t __new_sz) {
+    if (_S_slots(__new_sz) == _S_slots(__sz)) return true;
+    return backend_type::instance().pool.shrink_allocation(__p, _S_slots(__sz), _S_slots(__new_sz));
+  }
+
+  /// Checks whether @__p was carved out of this size class's shared pool
+  bool owns(const void *__p) const noexcept { return backend_type::instance().pool.owns(const_cast<void *>(__p)); }
+
+  /// Returns the committed-but-unused tail of the class's pool to the OS (non-binding, like shrink_to_fit)
+  bool shrink() { return backend_type::instance().pool.decommit_tail(); }
+
+ private:
+  using backend_type = __detail::size_class_backend<slot_bytes, Locker>;
+
+  // number of class slots covering @__n objects
+  static constexpr size_type _S_slots(size_type __n) { return (__n * sizeof(_Tp) + slot_bytes - 1) / slot_bytes; }
+
+  constexpr size_type _M_max_size() const noexcept { return std::size_t(__PTRDIFF_MAX__) / sizeof(_Tp); }
+};
+
+// equal exactly when both sides draw from the same size-class pool
+template <typename _Tp1, typename _Tp2, typename _Locker>
+constexpr bool operator==(const sc_alloc<_Tp1, _Locker> &, const sc_alloc<_Tp2, _Locker> &) noexcept {
+  return sc_alloc<_Tp1, _Locker>::slot_bytes == sc_alloc<_Tp2, _Locker>::slot_bytes;
+}
+
+template <typename _Tp1, typename _Tp2, typename _Locker>
+constexpr bool operator!=(const sc_alloc<_Tp1, _Locker> &__a, const sc_alloc<_Tp2, _Locker> &__b) noexcept {
+  return !(__a == __b);
+}
+
+}  // namespace ak_allocator
+
+#endif
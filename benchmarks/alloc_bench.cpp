@@ -0,0 +1,98 @@
+// clang-format off
+
+#include "../allocator/page_allocator.h"
+#include "../container/vector.h"
+
+// clang-format on
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Microbenchmarks for the page_allocator hot paths, comparing against std::allocator:
+ *  - vector push_back growth (in-place extend_allocation vs. realloc-copy)
+ *  - std::map node churn (insert/erase steady state over the free list)
+ *  - pool init/teardown cost
+ *  - first-touch page-commit latency
+ *
+ * Self-contained on purpose (no benchmark library dependency): each case reports ns/op
+ * over enough iterations to make the clock overhead irrelevant.
+ */
+
+namespace {
+
+// keep the optimizer from deleting the measured work
+template <typename T>
+inline void do_not_optimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename F>
+void bench(const std::string &name, std::size_t iters, F &&fn) {
+  using clock = std::chrono::steady_clock;
+  // one warmup pass so lazily-created pools and caches do not pollute the measurement
+  fn();
+  auto start = clock::now();
+  for (std::size_t i = 0; i < iters; ++i) fn();
+  auto stop = clock::now();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  std::cout << name << ": " << (static_cast<double>(ns) / static_cast<double>(iters)) << " ns/op  [" << iters << " iters]" << std::endl;
+}
+
+template <typename Vector>
+void vector_growth() {
+  Vector v;
+  for (int i = 0; i < 100000; ++i) v.push_back(i);
+  do_not_optimize(v.data());
+}
+
+template <typename Map>
+void map_churn() {
+  Map m;
+  for (int i = 0; i < 512; ++i) m[i] = i;
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 512; i += 2) m.erase(i);
+    for (int i = 0; i < 512; i += 2) m[i] = i + round;
+  }
+  do_not_optimize(m.size());
+}
+
+void pool_lifecycle() {
+  ak_allocator::p_alloc<long, 0> a;
+  long *p = a.allocate(1);
+  do_not_optimize(p);
+  a.deallocate(p, 1);
+}
+
+template <typename Alloc>
+void first_touch_commit() {
+  Alloc a;
+  constexpr std::size_t n = (1u << 20) / sizeof(long);  // 1 MB
+  long *p = a.allocate(n);
+  for (std::size_t i = 0; i < n; i += 4096 / sizeof(long)) p[i] = static_cast<long>(i);  // touch every page
+  do_not_optimize(p[n - 1]);
+  a.deallocate(p, n);
+}
+
+}  // namespace
+
+int main() {
+  using p_vec = ak_container::vector<int, ak_allocator::p_alloc<int, 0>>;
+  using std_vec = std::vector<int>;
+  using p_map = std::map<int, int, std::less<int>, ak_allocator::p_alloc<std::pair<const int, int>, 0>>;
+  using std_map = std::map<int, int>;
+
+  bench("vector_growth<p_alloc>   ", 50, vector_growth<p_vec>);
+  bench("vector_growth<std_alloc> ", 50, vector_growth<std_vec>);
+  bench("map_churn<p_alloc>       ", 200, map_churn<p_map>);
+  bench("map_churn<std_alloc>     ", 200, map_churn<std_map>);
+  bench("pool_init_teardown       ", 2000, pool_lifecycle);
+  bench("first_touch_1MB<p_alloc> ", 200, first_touch_commit<ak_allocator::p_alloc<long, 0>>);
+  bench("first_touch_1MB<std>     ", 200, first_touch_commit<std::allocator<long>>);
+
+  return 0;
+}
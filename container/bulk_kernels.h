@@ -0,0 +1,95 @@
+#ifndef _BULK_KERNELS_H_
+#define _BULK_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace ak_container {
+
+namespace __detail {
+
+// Explicitly vectorized fill/copy kernels for trivially-copyable element types. ak_container::vector routes its
+// _M_fill_assign / _M_allocate_and_copy bulk work here when the allocator advertises continuous_allocator (the
+// page_allocator hands out page-aligned buffers, so the wide stores land on well-aligned memory). The AVX2 paths
+// need -mavx2 (or -march=native); without it the kernels degrade to memcpy/std::fill_n, which the compiler
+// auto-vectorizes but never streams.
+
+// Byte count above which the stores bypass the cache (non-temporal): buffers this big do not fit the L2 anyway,
+// and streaming them avoids evicting the working set just to write data that will be read much later.
+inline constexpr std::size_t nt_threshold = 1u << 20;
+
+/**
+ * @brief The function fills @n elements at @dst with copies of @val
+ *
+ * @param dst  destination, holds raw or already-constructed storage for @n elements;
+ * @param n    the number of elements to fill;
+ * @param val  the fill value (read once into a register pattern before the first store, so @val may alias @dst).
+ *
+ * With AVX2 and an element size dividing 32, the value is broadcast into one 32-byte pattern and written with
+ * 256-bit stores - non-temporal ones for buffers over nt_threshold when the destination is 32-byte aligned.
+ */
+template <typename _Tp>
+inline void bulk_fill(_Tp *dst, std::size_t n, const _Tp &val) {
+  static_assert(std::is_trivially_copyable<_Tp>::value, "bulk_fill writes elements as raw bytes");
+#ifdef __AVX2__
+  if constexpr (sizeof(_Tp) <= 32 && 32 % sizeof(_Tp) == 0) {
+    alignas(32) unsigned char pattern[32];
+    for (std::size_t i = 0; i < 32; i += sizeof(_Tp)) std::memcpy(pattern + i, &val, sizeof(_Tp));
+    const __m256i chunk = _mm256_load_si256(reinterpret_cast<const __m256i *>(pattern));
+
+    unsigned char *out = reinterpret_cast<unsigned char *>(dst);
+    const std::size_t bytes = n * sizeof(_Tp);
+    std::size_t i = 0;
+    if (bytes >= nt_threshold && (reinterpret_cast<std::uintptr_t>(out) & 31) == 0) {
+      for (; i + 32 <= bytes; i += 32) _mm256_stream_si256(reinterpret_cast<__m256i *>(out + i), chunk);
+      _mm_sfence();
+    } else
+      for (; i + 32 <= bytes; i += 32) _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), chunk);
+    for (; i < bytes; i += sizeof(_Tp)) std::memcpy(out + i, pattern, sizeof(_Tp));
+    return;
+  }
+#endif
+  // the pattern trick does not pay off for odd element sizes (or without AVX2); let the compiler vectorize
+  _Tp tmp(val);  // copy first: @val may alias @dst
+  for (std::size_t i = 0; i < n; ++i) std::memcpy(dst + i, &tmp, sizeof(_Tp));
+}
+
+/**
+ * @brief The function copies @n elements from @src to @dst (the ranges must not overlap)
+ *
+ * @param dst  destination, holds raw or already-constructed storage for @n elements;
+ * @param src  source range of @n elements;
+ * @param n    the number of elements to copy.
+ *
+ * memcpy is already the fastest cached copy; the kernel only adds the non-temporal variant for buffers over
+ * nt_threshold, which a plain memcpy cannot be told to use.
+ */
+template <typename _Tp>
+inline void bulk_copy(_Tp *dst, const _Tp *src, std::size_t n) {
+  static_assert(std::is_trivially_copyable<_Tp>::value, "bulk_copy moves elements as raw bytes");
+  const std::size_t bytes = n * sizeof(_Tp);
+#ifdef __AVX2__
+  unsigned char *out = reinterpret_cast<unsigned char *>(dst);
+  const unsigned char *in = reinterpret_cast<const unsigned char *>(src);
+  if (bytes >= nt_threshold && (reinterpret_cast<std::uintptr_t>(out) & 31) == 0) {
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) _mm256_stream_si256(reinterpret_cast<__m256i *>(out + i), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)));
+    _mm_sfence();
+    if (i < bytes) std::memcpy(out + i, in + i, bytes - i);
+    return;
+  }
+#endif
+  std::memcpy(dst, src, bytes);
+}
+
+}  // namespace __detail
+
+}  // namespace ak_container
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef _CONTAINER_MAP_H_
+#define _CONTAINER_MAP_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "../allocator/page_allocator.h"
+
+namespace ak_container {
+
+/**
+ * std::map rebinds its allocator once per node and allocates nodes one at a time, which fights the pool twice: every
+ * insert is a full get_allocation round trip, and the _MaxObjects throttle of page_allocator counts those singles.
+ * batch_alloc sits between the tree and the pool: single-object requests are carved from batches of _BatchSlots slots
+ * obtained in ONE get_allocation call, so sibling nodes are contiguous (cache-line-packed for small nodes) and the
+ * pool is touched once per batch. Freed nodes go onto an in-node free list and are reused before the batch bump
+ * pointer moves. Requests for more than one object pass straight through to the inner allocator.
+ *
+ * The batches themselves are never returned individually - the pool reclaims them wholesale when the inner
+ * allocator tears its mapping down, which is exactly the lifetime of the owning container.
+ */
+template <typename _Tp, std::size_t _BatchSlots = 16, typename _Inner = ak_allocator::p_alloc<_Tp, 0>>
+class batch_alloc {
+ public:
+  using value_type = _Tp;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <typename _Tp1>
+  struct rebind {
+    using other = batch_alloc<_Tp1, _BatchSlots, typename std::allocator_traits<_Inner>::template rebind_alloc<_Tp1>>;
+  };
+
+  batch_alloc() noexcept = default;
+
+  // the free list and the current batch live in the other pool, so a copy starts with an empty cache (and the
+  // inner copy is lazy - no mapping until the first node)
+  batch_alloc(const batch_alloc &other) noexcept : _inner(other._inner) {}
+
+  batch_alloc(batch_alloc &&rhs) noexcept : _inner(std::move(rhs._inner)), _free(rhs._free), _batch(rhs._batch), _slots_left(rhs._slots_left) {
+    rhs._free = nullptr;
+    rhs._batch = nullptr;
+    rhs._slots_left = 0;
+  }
+
+  // Conversion copy Ctor (the rebind-per-node pattern of std::map lands here)
+  template <typename _Tp1, typename _Inner1>
+  batch_alloc(const batch_alloc<_Tp1, _BatchSlots, _Inner1> &other) noexcept : _inner(other.get_inner()) {}
+
+  batch_alloc &operator=(const batch_alloc &other) {
+    _inner = other._inner;
+    _free = nullptr;
+    _batch = nullptr;
+    _slots_left = 0;
+    return *this;
+  }
+
+  batch_alloc &operator=(batch_alloc &&rhs) {
+    _inner = std::move(rhs._inner);
+    _free = rhs._free;
+    _batch = rhs._batch;
+    _slots_left = rhs._slots_left;
+    rhs._free = nullptr;
+    rhs._batch = nullptr;
+    rhs._slots_left = 0;
+    return *this;
+  }
+
+  [[__nodiscard__]] _Tp *allocate(size_type __n, const void * = static_cast<const void *>(0)) {
+    if constexpr (sizeof(_Tp) >= sizeof(free_node)) {
+      if (__n == 1) {
+        if (_free != nullptr) {
+          free_node *node = _free;
+          _free = node->next;
+          return reinterpret_cast<_Tp *>(node);
+        }
+        if (_slots_left == 0) {
+          // one pool transaction covers the whole batch of node-sized blocks
+          if (_batch = _inner.allocate_batch(_BatchSlots, 1); _batch == nullptr) return nullptr;
+          _slots_left = _BatchSlots;
+        }
+        --_slots_left;
+        return _batch++;
+      }
+    }
+    return _inner.allocate(__n);
+  }
+
+  void deallocate(_Tp *__p, size_type __t) {
+    if constexpr (sizeof(_Tp) >= sizeof(free_node)) {
+      if (__t == 1) {
+        free_node *node = reinterpret_cast<free_node *>(__p);
+        node->next = _free;
+        _free = node;
+        return;
+      }
+    }
+    _inner.deallocate(__p, __t);
+  }
+
+  const _Inner &get_inner() const noexcept { return _inner; }
+
+ private:
+  // freed nodes carry the list in-place, like mem_pool's free_node
+  struct free_node {
+    free_node *next;
+  };
+
+  _Inner _inner;
+
+  // head of the list of freed single slots, reused before the batch advances
+  free_node *_free{nullptr};
+
+  // bump pointer into the current batch and the slots still unused in it
+  _Tp *_batch{nullptr};
+  size_type _slots_left{0};
+};
+
+template <typename _Tp1, typename _Tp2, std::size_t _BatchSlots, typename _Inner1, typename _Inner2>
+bool operator==(const batch_alloc<_Tp1, _BatchSlots, _Inner1> &__a, const batch_alloc<_Tp2, _BatchSlots, _Inner2> &__b) noexcept {
+  return __a.get_inner() == __b.get_inner();
+}
+
+template <typename _Tp1, typename _Tp2, std::size_t _BatchSlots, typename _Inner1, typename _Inner2>
+bool operator!=(const batch_alloc<_Tp1, _BatchSlots, _Inner1> &__a, const batch_alloc<_Tp2, _BatchSlots, _Inner2> &__b) noexcept {
+  return !(__a == __b);
+}
+
+// Ordered map over pool-batched nodes: drop-in for std::map, nodes contiguous in _BatchSlots-sized groups
+template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>, std::size_t _BatchSlots = 16>
+using map = std::map<_Key, _Tp, _Compare, batch_alloc<std::pair<const _Key, _Tp>, _BatchSlots>>;
+
+}  // namespace ak_container
+
+#endif
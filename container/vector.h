@@ -7,6 +7,7 @@
  * https://gcc.gnu.org/onlinedocs/gcc-10.2.0/libstdc++/api/tables.html
  */
 
+#include "bulk_kernels.h"
 #include "vector_inner.h"
 
 namespace ak_container {
@@ -81,8 +82,19 @@ class vector : protected ak_vector_inner::_Vector_base<_Tp, _Alloc> {
   static pointer _S_do_relocate(pointer, pointer, pointer __result, _Tp_alloc_type &, std::false_type) noexcept { return __result; }
 
   static pointer _S_relocate(pointer __first, pointer __last, pointer __result, _Tp_alloc_type &__alloc) noexcept {
-    using __do_it = std::__bool_constant<_S_use_relocate()>;
-    return _S_do_relocate(__first, __last, __result, __alloc, __do_it{});
+    // Reallocation between two pool buffers: with a continuous_allocator both sides are page-aligned and a
+    // trivially-copyable _Tp (trivial dtor included, so nothing to destroy in the source) relocates as raw
+    // bytes - one bulk_copy, non-temporal above nt_threshold, instead of __relocate_a's element loop. The
+    // pools hand out interior runs of a shared mapping, not whole mappings, so an mremap of the pages is not
+    // available here; the streaming copy is the closest the layout allows.
+    if constexpr (expander<allocator_type>::page_aligned && std::is_trivially_copyable<_Tp>::value) {
+      const size_type __n = static_cast<size_type>(__last - __first);
+      if (__n != 0) __detail::bulk_copy(std::__to_address(__result), std::__to_address(__first), __n);
+      return __result + __n;
+    } else {
+      using __do_it = std::__bool_constant<_S_use_relocate()>;
+      return _S_do_relocate(__first, __last, __result, __alloc, __do_it{});
+    }
   }
 
  protected:
@@ -789,12 +801,19 @@ class vector : protected ak_vector_inner::_Vector_base<_Tp, _Alloc> {
   template <typename _ForwardIterator>
   pointer _M_allocate_and_copy(size_type __n, _ForwardIterator __first, _ForwardIterator __last) {
     pointer __result = this->_M_allocate(__n);
-    try {
-      std::__uninitialized_copy_a(__first, __last, __result, _M_get_Tp_allocator());
+    if constexpr (expander<allocator_type>::page_aligned && std::is_trivially_copyable<_Tp>::value &&
+                  !std::is_same<decltype(_S_contiguous(std::declval<_ForwardIterator>())), std::nullptr_t>::value) {
+      // page-aligned destination, trivially-copyable elements, pointer source: one bulk (possibly non-temporal) copy
+      __detail::bulk_copy(std::__to_address(__result), _S_contiguous(__first), static_cast<size_type>(std::distance(__first, __last)));
       return __result;
-    } catch (...) {
-      _M_deallocate(__result, __n);
-      throw;
+    } else {
+      try {
+        std::__uninitialized_copy_a(__first, __last, __result, _M_get_Tp_allocator());
+        return __result;
+      } catch (...) {
+        _M_deallocate(__result, __n);
+        throw;
+      }
     }
   }
   template <typename _InputIterator>
@@ -816,7 +835,11 @@ class vector : protected ak_vector_inner::_Vector_base<_Tp, _Alloc> {
   }
 
   void _M_fill_initialize(size_type __n, const value_type &__value) {
-    this->_M_impl._M_finish = std::__uninitialized_fill_n_a(this->_M_impl._M_start, __n, __value, _M_get_Tp_allocator());
+    if constexpr (expander<allocator_type>::page_aligned && std::is_trivially_copyable<_Tp>::value) {
+      __detail::bulk_fill(std::__to_address(this->_M_impl._M_start), __n, __value);
+      this->_M_impl._M_finish = this->_M_impl._M_start + __n;
+    } else
+      this->_M_impl._M_finish = std::__uninitialized_fill_n_a(this->_M_impl._M_start, __n, __value, _M_get_Tp_allocator());
   }
 
   void _M_default_initialize(size_type __n) { this->_M_impl._M_finish = std::__uninitialized_default_n_a(this->_M_impl._M_start, __n, _M_get_Tp_allocator()); }
@@ -1001,6 +1024,10 @@ class vector : protected ak_vector_inner::_Vector_base<_Tp, _Alloc> {
   template <typename _Al, typename = void>
   struct expander {
     static bool extend(_Al &, pointer, std::size_t, std::size_t) { return false; }
+    static bool trim(_Al &, pointer, std::size_t, std::size_t) { return false; }
+    static void decommit(_Al &) {}
+    // nothing guarantees the alignment of a std allocation, so the bulk kernels stay off
+    static constexpr bool page_aligned = false;
   };
 
   // implementation to use custom version of allocator that has
@@ -1012,8 +1039,27 @@ class vector : protected ak_vector_inner::_Vector_base<_Tp, _Alloc> {
       if (size_type new_len = new_sz; a.extend_allocation(ptr, sz, new_len)) return true;
       return false;
     }
+    static bool trim(_Al &a, pointer ptr, std::size_t sz, std::size_t new_sz) { return a.shrink_allocation(ptr, sz, new_sz); }
+    static void decommit(_Al &a) { a.shrink(); }
+    // the pool's allocation_area starts on a page boundary, so buffers are 4096-byte aligned and the
+    // explicitly vectorized fill/copy kernels of bulk_kernels.h apply (for trivially-copyable _Tp)
+    static constexpr bool page_aligned = true;
   };
 
+  // Unwraps iterators that are really raw pointers into contiguous memory (including move_iterator over such,
+  // which _M_allocate_and_copy gets from __make_move_if_noexcept_iterator); any other iterator yields nullptr_t
+  // and the caller keeps the generic path.
+  static constexpr value_type *_S_contiguous(value_type *__p) { return __p; }
+  static constexpr const value_type *_S_contiguous(const value_type *__p) { return __p; }
+  template <typename _It>
+  static constexpr auto _S_contiguous(std::move_iterator<_It> __it) {
+    return _S_contiguous(__it.base());
+  }
+  template <typename _It>
+  static constexpr std::nullptr_t _S_contiguous(_It) {
+    return nullptr;
+  }
+
   bool grow(std::size_t nmbr) {
     bool retValue = false;
     if (pointer ptr = _M_impl._M_start; ptr) {
@@ -1201,7 +1247,12 @@ void vector<_Tp, _Alloc>::_M_fill_assign(size_t __n, const value_type &__val) {
       vector __tmp(__n, __val, _M_get_Tp_allocator());
       __tmp._M_impl._M_swap_data(this->_M_impl);
     }
-  else if (__n > size()) {
+  else if constexpr (expander<allocator_type>::page_aligned && std::is_trivially_copyable<_Tp>::value) {
+    // trivial elements: one wide fill over [start, start + n) replaces the fill + uninitialized-fill split
+    // (bulk_fill snapshots __val before the first store, so a __val aliasing the vector stays safe)
+    __detail::bulk_fill(std::__to_address(this->_M_impl._M_start), __n, __val);
+    this->_M_impl._M_finish = this->_M_impl._M_start + __n;
+  } else if (__n > size()) {
     std::fill(begin(), end(), __val);
     const size_type __add = __n - size();
     this->_M_impl._M_finish = std::__uninitialized_fill_n_a(this->_M_impl._M_finish, __add, __val, _M_get_Tp_allocator());
@@ -1429,8 +1480,28 @@ void vector<_Tp, _Alloc>::_M_default_append(size_type __n) {
 
 template <typename _Tp, typename _Alloc>
 bool vector<_Tp, _Alloc>::_M_shrink_to_fit() {
-  if (capacity() == size()) return false;
-  return std::__shrink_to_fit_aux<vector>::_S_do_it(*this);
+  bool done = false;
+  // a continuous allocator can return the capacity tail in place - a constant-time metadata
+  // update instead of the copy-and-swap below (an empty vector must really deallocate, so it
+  // is left to the generic path)
+  if (capacity() != size() && size() != 0 &&
+      expander<allocator_type>::trim(_M_get_Tp_allocator(), this->_M_impl._M_start, capacity(), size())) {
+    this->_M_impl._M_end_of_storage = this->_M_impl._M_start + size();
+    done = true;
+  }
+  // the std::__shrink_to_fit_aux helper is not usable from outside namespace std (unqualified
+  // __make_move_if_noexcept_iterator calls in it don't resolve here), so do the same copy-and-swap inline
+  else if (capacity() != size()) {
+    try {
+      vector(std::__make_move_if_noexcept_iterator(this->_M_impl._M_start), std::__make_move_if_noexcept_iterator(this->_M_impl._M_finish), get_allocator())
+          .swap(*this);
+      done = true;
+    } catch (...) {
+    }
+  }
+  // a continuous allocator can also hand committed-but-unused pool pages back to the OS
+  expander<allocator_type>::decommit(_M_get_Tp_allocator());
+  return done;
 }
 
 template <typename _Tp, typename _Alloc>
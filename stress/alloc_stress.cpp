@@ -0,0 +1,292 @@
+// clang-format off
+
+#include "../allocator/page_allocator.h"
+#include "../container/map.h"
+#include "../container/vector.h"
+
+// clang-format on
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Correctness-under-load harness (not a benchmark): hammers page_allocator directly and through
+ * ak_container::vector / std::map with randomized interleavings of allocate / deallocate / extend /
+ * shrink / copy / move / swap, and checks the pool's invariants after every operation:
+ *
+ *  - occupied_slots + free_slots_left minus the free-list total stays constant while the mapping does
+ *    (occupied_slots is the watermark and still covers free-list holes, which free_slots_left also
+ *    counts - the same accounting grow_pool uses to compute live slots);
+ *  - live allocations never overlap: every block is filled with a block-specific byte pattern that is
+ *    verified before the block is freed, so any overlap or stray write trips the check;
+ *  - the guard pages bracketing the usable area stay PROT_NONE (checked against /proc/self/maps);
+ *  - containers over the pool stay element-for-element equal to std:: reference containers driven by
+ *    the same operation sequence.
+ *
+ * A final phase runs the spin_lock pool from several threads with cross-thread frees, exercising the
+ * remote-free queue. Usage: allocator_stress [seed] [iters] - the seed is printed so a failing run can
+ * be replayed; any failure aborts with a message.
+ */
+
+namespace {
+
+std::mt19937 rng;
+
+void fail(const char *what) {
+  std::cerr << "FAIL: " << what << std::endl;
+  std::abort();
+}
+
+void check(bool ok, const char *what) {
+  if (!ok) fail(what);
+}
+
+// The guard pages can't be probed by touching them; read their protection back from /proc/self/maps
+bool region_is_inaccessible(const void *addr) {
+  std::FILE *maps = std::fopen("/proc/self/maps", "r");
+  if (maps == nullptr) return true;  // no procfs - skip the check rather than fail
+  const std::uintptr_t target = reinterpret_cast<std::uintptr_t>(addr);
+  char line[256];
+  bool found = false, inaccessible = false;
+  while (std::fgets(line, sizeof(line), maps) != nullptr) {
+    std::uintptr_t lo, hi;
+    char perms[5] = {0};
+    if (std::sscanf(line, "%lx-%lx %4s", &lo, &hi, perms) != 3) continue;
+    if (target >= lo && target < hi) {
+      found = true;
+      inaccessible = perms[0] == '-' && perms[1] == '-';
+      break;
+    }
+  }
+  std::fclose(maps);
+  return !found || inaccessible;
+}
+
+// one live allocation of the fuzz phase: where it is, how big, and the byte its pattern is built from
+struct block {
+  int *ptr;
+  std::size_t n;
+  unsigned char tag;
+};
+
+void fill_block(const block &b) {
+  for (std::size_t i = 0; i < b.n; ++i) b.ptr[i] = static_cast<int>((b.tag << 16) | (i & 0xffff));
+}
+
+void verify_block(const block &b) {
+  for (std::size_t i = 0; i < b.n; ++i)
+    if (b.ptr[i] != static_cast<int>((b.tag << 16) | (i & 0xffff))) fail("block pattern corrupted (overlap or stray write)");
+}
+
+// randomized allocate/deallocate/extend/shrink/swap against the raw allocator, with the shadow list
+// of live blocks enforcing the no-overlap and accounting invariants
+void raw_pool_phase(std::size_t iters) {
+  using alloc_t = ak_allocator::p_alloc<int, 0>;
+  alloc_t al;
+  std::vector<block> live;
+  std::size_t last_total = 0, last_pages = 0;
+  unsigned char next_tag = 1;
+  int last_op = -1;
+
+  auto recheck = [&] {
+    const auto &pool = al.get_mem_pool();
+    if (pool.begin_gp == nullptr) return;
+    std::size_t listed = 0;
+    for (auto *node = pool.free_list; node != nullptr; node = node->next) listed += node->slots;
+    std::size_t total = pool.occupied_slots + pool.free_slots_left - listed;
+    if (pool.pages_mmaped == last_pages && last_total != 0 && total != last_total) {
+      std::cerr << "drift: occupied=" << pool.occupied_slots << " free=" << pool.free_slots_left << " listed=" << listed << " total=" << total
+                << " last_total=" << last_total << " last_op=" << last_op << std::endl;
+      fail("slot accounting drifted within one mapping");
+    }
+    last_total = total;
+    last_pages = pool.pages_mmaped;
+    check(region_is_inaccessible(pool.begin_gp), "leading guard page lost PROT_NONE");
+    check(region_is_inaccessible(pool.end_gp), "trailing guard page lost PROT_NONE");
+  };
+
+  for (std::size_t i = 0; i < iters; ++i) {
+    last_op = static_cast<int>(rng() % 6);
+    switch (last_op) {
+      case 0:
+      case 1: {  // allocate
+        std::size_t n = 1 + rng() % 3000;
+        int *p = al.allocate(n);
+        if (p == nullptr) break;
+        for (const block &b : live)
+          check(p + n <= b.ptr || b.ptr + b.n <= p, "fresh allocation overlaps a live block");
+        live.push_back({p, n, next_tag++});
+        fill_block(live.back());
+        break;
+      }
+      case 2: {  // deallocate a random live block
+        if (live.empty()) break;
+        std::size_t at = rng() % live.size();
+        verify_block(live[at]);
+        al.deallocate(live[at].ptr, live[at].n);
+        live.erase(live.begin() + at);
+        break;
+      }
+      case 3: {  // extend in place (only the most recent block has a chance, but any pick is legal)
+        if (live.empty()) break;
+        block &b = live[rng() % live.size()];
+        std::size_t grown = b.n + 1 + rng() % 256;
+        verify_block(b);
+        if (al.extend_allocation(b.ptr, b.n, grown)) {
+          b.n = grown;
+          fill_block(b);
+        }
+        break;
+      }
+      case 4: {  // shrink in place
+        if (live.empty()) break;
+        block &b = live[rng() % live.size()];
+        if (b.n < 2) break;
+        std::size_t kept = 1 + rng() % (b.n - 1);
+        verify_block(b);
+        if (al.shrink_allocation(b.ptr, b.n, kept)) b.n = kept;
+        break;
+      }
+      case 5: {  // swap with a scratch allocator and swap back (mem_pool::swap is move-based; blocks must survive)
+        alloc_t other;
+        al.swap(other);
+        for (const block &b : live) check(other.owns(b.ptr), "swap lost track of a live block");
+        al.swap(other);
+        for (const block &b : live) verify_block(b);
+        break;
+      }
+    }
+    recheck();
+  }
+
+  for (const block &b : live) {
+    verify_block(b);
+    al.deallocate(b.ptr, b.n);
+  }
+  std::cout << "raw pool phase: ok (" << iters << " ops)" << std::endl;
+}
+
+// the pooled containers are driven op-for-op against std:: reference containers and compared
+void container_phase(std::size_t iters) {
+  ak_container::vector<int, ak_allocator::p_alloc<int, 0>> v;
+  std::vector<int> ref_v;
+  ak_container::map<int, int> m;
+  std::map<int, int> ref_m;
+
+  for (std::size_t i = 0; i < iters; ++i) {
+    switch (rng() % 8) {
+      case 0:
+      case 1: {
+        int val = static_cast<int>(rng());
+        v.push_back(val);
+        ref_v.push_back(val);
+        break;
+      }
+      case 2:
+        if (!v.empty()) {
+          v.pop_back();
+          ref_v.pop_back();
+        }
+        break;
+      case 3:
+        v.reserve(v.size() + rng() % 4096);
+        break;
+      case 4: {  // copy, then move the copy back over the original
+        auto copy(v);
+        check(copy.size() == ref_v.size(), "vector copy changed the size");
+        v = std::move(copy);
+        break;
+      }
+      case 5: {  // double swap through an empty vector must round-trip the contents
+        auto fresh = decltype(v)();
+        v.swap(fresh);
+        v.swap(fresh);
+        break;
+      }
+      case 6: {
+        int key = static_cast<int>(rng() % 512);
+        m[key] = key * 3;
+        ref_m[key] = key * 3;
+        break;
+      }
+      case 7: {
+        int key = static_cast<int>(rng() % 512);
+        m.erase(key);
+        ref_m.erase(key);
+        break;
+      }
+    }
+    if (i % 64 == 0) {
+      check(v.size() == ref_v.size() && std::equal(ref_v.begin(), ref_v.end(), v.begin()), "vector diverged from std::vector reference");
+      check(m.size() == ref_m.size() && std::equal(ref_m.begin(), ref_m.end(), m.begin()), "map diverged from std::map reference");
+    }
+  }
+  check(v.size() == ref_v.size() && std::equal(ref_v.begin(), ref_v.end(), v.begin()), "vector diverged from std::vector reference");
+  check(m.size() == ref_m.size() && std::equal(ref_m.begin(), ref_m.end(), m.begin()), "map diverged from std::map reference");
+  std::cout << "container phase: ok (" << iters << " ops)" << std::endl;
+}
+
+// several threads share one spin_lock pool; half the frees are handed to another thread, so they land
+// in the remote-free queue instead of the owner's fast path
+void concurrent_phase(std::size_t iters_per_thread, unsigned seed) {
+  using alloc_t = ak_allocator::p_alloc_mt<long, 0>;
+  alloc_t al;
+  std::mutex handoff_mtx;
+  std::vector<std::pair<long *, std::size_t>> handoff;
+
+  auto worker = [&](unsigned tseed) {
+    std::mt19937 trng(tseed);
+    for (std::size_t i = 0; i < iters_per_thread; ++i) {
+      std::size_t n = 1 + trng() % 64;
+      long *p = al.allocate(n);
+      if (p == nullptr) continue;
+      for (std::size_t k = 0; k < n; ++k) p[k] = static_cast<long>(tseed + k);
+      for (std::size_t k = 0; k < n; ++k)
+        if (p[k] != static_cast<long>(tseed + k)) fail("concurrent block corrupted");
+
+      if (trng() % 2 == 0) {
+        al.deallocate(p, n);
+      } else {  // hand the block to whichever thread frees next - a guaranteed remote free for one side
+        std::lock_guard<std::mutex> lock(handoff_mtx);
+        handoff.emplace_back(p, n);
+        if (handoff.size() > 8) {
+          auto parked = handoff.front();
+          handoff.erase(handoff.begin());
+          al.deallocate(parked.first, parked.second);
+        }
+      }
+    }
+  };
+
+  std::thread t1(worker, seed + 1), t2(worker, seed + 2), t3(worker, seed + 3);
+  t1.join();
+  t2.join();
+  t3.join();
+  for (auto &parked : handoff) al.deallocate(parked.first, parked.second);
+  std::cout << "concurrent phase: ok (3 threads x " << iters_per_thread << " ops)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  unsigned seed = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : std::random_device{}();
+  std::size_t iters = argc > 2 ? std::stoul(argv[2]) : 20000;
+  std::cout << "seed " << seed << ", " << iters << " ops per phase" << std::endl;
+  rng.seed(seed);
+
+  raw_pool_phase(iters);
+  container_phase(iters);
+  concurrent_phase(iters / 4, seed);
+
+  std::cout << "all phases passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Decoder for the binary trace the trace_log policy writes (ak_alloc_trace_tsc.bin): emits Chrome
+ * trace-event JSON on stdout, loadable in chrome://tracing / Perfetto and convertible to flamegraphs.
+ *
+ *   trace_decode [trace-file] [tsc-ghz]
+ *
+ * trace-file defaults to ak_alloc_trace_tsc.bin. tsc-ghz is the TSC frequency used to convert cycles to the
+ * microseconds the trace-event format expects (default 1.0, i.e. timestamps stay in kilocycles - relative
+ * ordering and durations are still meaningful, only the absolute scale is off).
+ *
+ * Record layout, from log_traits.h:
+ *   tag 1 (definition): uint8 tag, uint32 id, uint16 len, len bytes of the function name
+ *   tag 3 (event):      uint8 tag, uint32 id, uint32 tid, uint64 tsc, uint64 n (UINT64_MAX = no size argument)
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+bool read_exact(std::FILE *in, void *dst, std::size_t len) { return std::fread(dst, 1, len, in) == len; }
+
+// the trace-event format chokes on raw backslashes/quotes; __PRETTY_FUNCTION__ contains neither, but stay safe
+void print_escaped(const std::string &s) {
+  for (char c : s) {
+    if (c == '"' || c == '\\') std::putchar('\\');
+    std::putchar(c);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : "ak_alloc_trace_tsc.bin";
+  const double tsc_ghz = argc > 2 ? std::atof(argv[2]) : 1.0;
+  if (tsc_ghz <= 0.0) {
+    std::fprintf(stderr, "trace_decode: bad tsc-ghz '%s'\n", argv[2]);
+    return 1;
+  }
+
+  std::FILE *in = std::fopen(path, "rb");
+  if (in == nullptr) {
+    std::fprintf(stderr, "trace_decode: can't open '%s'\n", path);
+    return 1;
+  }
+
+  std::unordered_map<std::uint32_t, std::string> names;
+  bool first = true;
+  std::uint64_t base_tsc = 0;  // timestamps are emitted relative to the first event
+
+  std::printf("{\"traceEvents\":[\n");
+  std::uint8_t tag;
+  while (read_exact(in, &tag, sizeof(tag))) {
+    if (tag == 1) {
+      std::uint32_t id;
+      std::uint16_t len;
+      if (!read_exact(in, &id, sizeof(id)) || !read_exact(in, &len, sizeof(len))) break;
+      std::string name(len, '\0');
+      if (!read_exact(in, &name[0], len)) break;
+      names[id] = name;
+    } else if (tag == 3) {
+      std::uint32_t id, tid;
+      std::uint64_t tsc, n;
+      if (!read_exact(in, &id, sizeof(id)) || !read_exact(in, &tid, sizeof(tid)) || !read_exact(in, &tsc, sizeof(tsc)) || !read_exact(in, &n, sizeof(n)))
+        break;
+      if (first) base_tsc = tsc;
+      const double ts_us = static_cast<double>(tsc - base_tsc) / (tsc_ghz * 1000.0);
+
+      if (!first) std::printf(",\n");
+      first = false;
+      std::printf("{\"name\":\"");
+      auto it = names.find(id);
+      print_escaped(it != names.end() ? it->second : "<unknown>");
+      std::printf("\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", tid, ts_us);
+      if (n != UINT64_MAX) std::printf(",\"args\":{\"n\":%llu}", static_cast<unsigned long long>(n));
+      std::printf("}");
+    } else {
+      std::fprintf(stderr, "trace_decode: unknown tag %u, stopping\n", tag);
+      break;
+    }
+  }
+  std::printf("\n]}\n");
+  std::fclose(in);
+  return 0;
+}